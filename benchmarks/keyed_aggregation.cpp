@@ -0,0 +1,161 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+// Measures the throughput of a keyed aggregation pipeline, i.e., a source
+// streaming (key, value) pairs into a partitioner that forwards each key to
+// exactly one worker. Runs the pipeline once per thread count from 1 up to
+// `scheduler.max-threads` (e.g., `--caf#scheduler.max-threads=8`), with one
+// worker per thread, and prints the results as CSV.
+
+#include <chrono>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <unordered_map>
+
+#include "caf/all.hpp"
+#include "caf/partitioner.hpp"
+
+using std::cout;
+using std::endl;
+using std::vector;
+
+using namespace caf;
+
+namespace {
+
+using done_atom = atom_constant<atom("done")>;
+
+using element = std::pair<int, int>;
+
+struct key_fn {
+  int operator()(const element& x) const {
+    return x.first;
+  }
+};
+
+struct config : actor_system_config {
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(num_values, "num-values,n", "set number of streamed elements")
+    .add(num_keys, "num-keys,k", "set number of distinct keys")
+    .add(work, "work,w", "set number of hash rounds per element");
+  }
+  int num_values = 1000000;
+  int num_keys = 1024;
+  int work = 1000;
+};
+
+// Scrambles `x` for `rounds` iterations to simulate a costly aggregation.
+uint64_t busy_hash(uint64_t x, int rounds) {
+  for (int i = 0; i < rounds; ++i)
+    x = (x ^ (x >> 31)) * 0x7FB5D329728EA185ull;
+  return x;
+}
+
+using sums = std::unordered_map<int, uint64_t>;
+
+// Aggregates all elements for its keys and notifies `listener` when done.
+behavior worker(event_based_actor* self, actor stage, actor listener,
+                int work) {
+  self->send(self * stage, join_atom::value);
+  return {
+    [=](stream<element>& in) {
+      self->send(listener, ok_atom::value);
+      return self->make_sink(
+        in,
+        [](sums&) {
+          // nop
+        },
+        [=](sums& xs, element x) {
+          xs[x.first] += busy_hash(static_cast<uint64_t>(x.second), work);
+        },
+        [=](sums&) {
+          self->send(listener, done_atom::value);
+        }
+      );
+    }
+  };
+}
+
+void source(event_based_actor* self, actor dest, int num_values,
+            int num_keys) {
+  self->make_source(
+    dest,
+    [](int& x) {
+      x = 0;
+    },
+    [=](int& x, downstream<element>& out, size_t num) {
+      auto n = std::min(static_cast<int>(num), num_values - x);
+      for (int i = 0; i < n; ++i, ++x)
+        out.push(x % num_keys, x);
+    },
+    [=](const int& x) {
+      return x == num_values;
+    },
+    [](expected<void>) {
+      // nop
+    }
+  );
+}
+
+// Returns the time in milliseconds for streaming all elements to `n` workers.
+long long run(actor_system& sys, const config& cfg, size_t n) {
+  scoped_actor self{sys};
+  auto stage = sys.spawn(partitioner<element, key_fn>);
+  vector<actor> workers;
+  for (size_t i = 0; i < n; ++i)
+    workers.push_back(sys.spawn(worker, stage, actor{self}, cfg.work));
+  // Wait until all workers joined the stage.
+  size_t i = 0;
+  self->receive_for(i, n)([](ok_atom) {
+    // nop
+  });
+  auto t0 = std::chrono::steady_clock::now();
+  sys.spawn(source, stage, cfg.num_values, cfg.num_keys);
+  i = 0;
+  self->receive_for(i, n)([](done_atom) {
+    // nop
+  });
+  auto t1 = std::chrono::steady_clock::now();
+  for (auto& x : workers)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  anon_send_exit(stage, exit_reason::user_shutdown);
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  return duration_cast<milliseconds>(t1 - t0).count();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+  config cfg;
+  cfg.parse(argc, argv);
+  if (cfg.cli_helptext_printed)
+    return 0;
+  auto max_threads = cfg.scheduler_max_threads;
+  cout << "threads,workers,elements,time_ms,elements_per_s" << endl;
+  for (size_t n = 1; n <= max_threads; ++n) {
+    cfg.scheduler_max_threads = n;
+    actor_system sys{cfg};
+    auto ms = run(sys, cfg, n);
+    cout << n << ',' << n << ',' << cfg.num_values << ',' << ms << ','
+         << (ms > 0 ? cfg.num_values * 1000ll / ms : 0) << endl;
+  }
+}
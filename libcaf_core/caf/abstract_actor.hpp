@@ -99,6 +99,16 @@ public:
   /// an empty set if this actor is untyped.
   virtual std::set<std::string> message_types() const;
 
+  /// Returns an estimate for the number of messages waiting in the mailbox
+  /// or 0 if this actor has no mailbox, e.g., proxies, or if mailbox size
+  /// tracking is disabled.
+  /// @threadsafe
+  virtual size_t mailbox_size_hint() const noexcept;
+
+  /// Enables `mailbox_size_hint` for this actor.
+  /// @threadsafe
+  virtual void track_mailbox_size();
+
   /// Returns the ID of this actor.
   actor_id id() const noexcept;
 
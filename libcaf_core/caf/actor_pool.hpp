@@ -23,14 +23,15 @@
 #include <vector>
 #include <functional>
 
-#include "caf/locks.hpp"
 #include "caf/actor.hpp"
+#include "caf/make_actor.hpp"
 #include "caf/execution_unit.hpp"
 #include "caf/mailbox_element.hpp"
 #include "caf/monitorable_actor.hpp"
 
+#include "caf/detail/rcu_ptr.hpp"
 #include "caf/detail/split_join.hpp"
-#include "caf/detail/shared_spinlock.hpp"
+#include "caf/detail/pool_policies.hpp"
 
 namespace caf {
 
@@ -55,23 +56,63 @@ namespace caf {
 /// during the enqueue operation. Any user-defined policy thus has to dispatch
 /// messages with as little overhead as possible, because the dispatching
 /// runs in the context of the sender.
+///
+/// The set of workers is stored in an `rcu_ptr`, i.e., senders dispatch on
+/// an immutable snapshot without acquiring a lock. The pool stores its policy
+/// by value, i.e., passing a policy of concrete type to `make` avoids the
+/// type erasure of `std::function`. A policy is a function object with
+/// signature `void (actor_system&, const actor_vec&, mailbox_element_ptr&,
+/// execution_unit*)` that gets called concurrently by all senders. Policies
+/// of concrete type may also provide `workers_changed(const actor_vec&)`,
+/// which the pool calls with the new set of workers before publishing it.
 /// @experimental
 class actor_pool : public monitorable_actor {
 public:
-  using uplock = upgrade_lock<detail::shared_spinlock>;
   using actor_vec = std::vector<actor>;
   using factory = std::function<actor ()>;
-  using policy = std::function<void (actor_system&, uplock&, const actor_vec&,
+  using policy = std::function<void (actor_system&, const actor_vec&,
                                      mailbox_element_ptr&, execution_unit*)>;
 
   /// Returns a simple round robin dispatching policy.
-  static policy round_robin();
+  static detail::round_robin_policy round_robin();
 
   /// Returns a broadcast dispatching policy.
-  static policy broadcast();
+  static detail::broadcast_policy broadcast();
 
   /// Returns a random dispatching policy.
-  static policy random();
+  static detail::random_policy random();
+
+  /// Returns a dispatching policy that selects the worker with the
+  /// fewest messages in its mailbox.
+  static detail::least_loaded_policy least_loaded();
+
+  /// Returns a dispatching policy that samples two workers at random and
+  /// selects the one with fewer messages in its mailbox.
+  static detail::power_of_two_policy power_of_two();
+
+  /// Returns a dispatching policy that selects a worker by hashing the key
+  /// returned by `f`. Messages with equal keys reach the same worker while
+  /// the set of workers remains unchanged.
+  /// @tparam KeyFn Function object with signature
+  ///               `T (const type_erased_tuple&)`, where `T` is hashable
+  ///               via `std::hash<T>`.
+  template <class KeyFn>
+  static detail::key_hash_policy<KeyFn> key_hash(KeyFn f) {
+    return detail::key_hash_policy<KeyFn>{std::move(f)};
+  }
+
+  /// Returns a dispatching policy that selects a worker by looking up the key
+  /// returned by `f` on a consistent hash ring with `virtual_nodes` points
+  /// per worker. Unlike `key_hash`, adding or removing a worker only remaps
+  /// the keys of that worker's ring segments.
+  /// @tparam KeyFn Function object with signature
+  ///               `T (const type_erased_tuple&)`, where `T` is hashable
+  ///               via `std::hash<T>`.
+  template <class KeyFn>
+  static detail::consistent_hash_policy<KeyFn>
+  consistent_hash(KeyFn f, size_t virtual_nodes = 100) {
+    return {std::move(f), virtual_nodes};
+  }
 
   /// Returns a split/join dispatching policy. The function object `sf`
   /// distributes a work item to all workers (split step) and the function
@@ -86,21 +127,32 @@ public:
   ///               The default split policy broadcasts the work item to all
   ///               workers.
   template <class T, class Join, class Split = detail::nop_split>
-  static policy split_join(Join jf, Split sf = Split(), T init = T()) {
-    using impl = detail::split_join<T, Split, Join>;
-    return impl{std::move(init), std::move(sf), std::move(jf)};
+  static detail::split_join<T, Split, Join>
+  split_join(Join jf, Split sf = Split(), T init = T()) {
+    return {std::move(init), std::move(sf), std::move(jf)};
   }
 
   ~actor_pool() override;
 
   /// Returns an actor pool without workers using the dispatch policy `pol`.
-  static actor make(execution_unit* eu, policy pol);
+  template <class Policy>
+  static actor make(execution_unit* eu, Policy pol) {
+    CAF_ASSERT(eu);
+    auto& sys = eu->system();
+    actor_config cfg{eu};
+    return make_actor<impl<Policy>, actor>(sys.next_actor_id(), sys.node(),
+                                           &sys, cfg, std::move(pol));
+  }
 
   /// Returns an actor pool with `n` workers created by the factory
   /// function `fac` using the dispatch policy `pol`.
-  static actor make(execution_unit* eu, size_t num_workers, const factory& fac, policy pol);
-
-  void enqueue(mailbox_element_ptr what, execution_unit* eu) override;
+  template <class Policy>
+  static actor make(execution_unit* eu, size_t num_workers,
+                    const factory& fac, Policy pol) {
+    auto res = make(eu, std::move(pol));
+    add_workers(res, num_workers, fac);
+    return res;
+  }
 
   actor_pool(actor_config& cfg);
 
@@ -108,19 +160,80 @@ protected:
   void on_cleanup() override;
 
 private:
-  bool filter(upgrade_lock<detail::shared_spinlock>&,
-              const strong_actor_ptr& sender, message_id mid,
-              message_view& mv, execution_unit* eu);
+  template <class Policy>
+  class impl;
+
+  static void add_workers(const actor& pool, size_t num_workers,
+                          const factory& fac);
+
+  // applies `f` to the set of workers, notifying the policy before
+  // publishing the result
+  template <class F>
+  void update_workers(F f) {
+    workers_.update([&](actor_vec& xs) {
+      f(xs);
+      workers_changed(xs);
+    });
+  }
+
+  // called with the new set of workers before it becomes visible to senders
+  virtual void workers_changed(const actor_vec& xs);
+
+  // handles system messages and returns `true` if `what` was consumed
+  bool filter(mailbox_element_ptr& what, execution_unit* eu);
+
+  // answers requests with an empty message if the pool has no workers
+  void bounce(mailbox_element_ptr& what, execution_unit* eu);
 
-  // call without workers_mtx_ held
   void quit(execution_unit* host);
 
-  detail::shared_spinlock workers_mtx_;
-  std::vector<actor> workers_;
-  policy policy_;
+  detail::rcu_ptr<actor_vec> workers_;
   exit_reason planned_reason_;
 };
 
+/// @cond PRIVATE
+
+template <class Policy>
+class actor_pool::impl final : public actor_pool {
+public:
+  impl(actor_config& cfg, Policy pol)
+      : actor_pool(cfg),
+        policy_(std::move(pol)) {
+    // nop
+  }
+
+  void enqueue(mailbox_element_ptr what, execution_unit* eu) override {
+    if (filter(what, eu))
+      return;
+    auto workers = workers_.read();
+    if (workers->empty()) {
+      bounce(what, eu);
+      return;
+    }
+    policy_(home_system(), *workers, what, eu);
+  }
+
+private:
+  template <class P>
+  static auto notify(P& x, const actor_vec& xs, int)
+  -> decltype(x.workers_changed(xs)) {
+    return x.workers_changed(xs);
+  }
+
+  template <class P>
+  static void notify(P&, const actor_vec&, long) {
+    // nop
+  }
+
+  void workers_changed(const actor_vec& xs) override {
+    notify(policy_, xs, 0);
+  }
+
+  Policy policy_;
+};
+
+/// @endcond
+
 } // namespace caf
 
 #endif // CAF_ACTOR_POOL_HPP
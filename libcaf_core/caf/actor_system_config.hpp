@@ -274,6 +274,17 @@ public:
   size_t work_stealing_relaxed_steal_interval;
   size_t work_stealing_relaxed_sleep_duration_us;
 
+  // -- config parameters for local groups -------------------------------------
+
+  size_t local_groups_fan_out_threshold;
+
+  // -- config parameters for streaming ----------------------------------------
+
+  atom_value stream_credit_policy;
+  size_t stream_credit_time_budget_us;
+  size_t stream_batch_time_budget_us;
+  size_t stream_max_credit;
+
   // -- config parameters for the logger ---------------------------------------
 
   std::string logger_file_name;
@@ -298,6 +309,7 @@ public:
   size_t middleman_heartbeat_interval;
   bool middleman_detach_utility_actors;
   bool middleman_detach_multiplexer;
+  size_t middleman_max_pending_stream_bytes;
 
   // -- config parameters of the OpenCL module ---------------------------------
 
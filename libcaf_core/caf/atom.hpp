@@ -126,6 +126,9 @@ using leave_atom = atom_constant<atom("leave")>;
 /// Used for signaling forwarding paths.
 using forward_atom = atom_constant<atom("forward")>;
 
+/// Used for sending a single message to multiple remote actors.
+using multicast_atom = atom_constant<atom("multicast")>;
+
 /// Used for buffer management.
 using flush_atom = atom_constant<atom("flush")>;
 
@@ -168,6 +171,9 @@ using migrate_atom = atom_constant<atom("migrate")>;
 /// Used for triggering periodic operations.
 using tick_atom = atom_constant<atom("tick")>;
 
+/// Used for flushing partially filled stream batches.
+using stream_atom = atom_constant<atom("stream")>;
+
 } // namespace caf
 
 namespace std {
@@ -20,6 +20,8 @@
 #ifndef CAF_BROADCAST_SCATTERER_HPP
 #define CAF_BROADCAST_SCATTERER_HPP
 
+#include <algorithm>
+
 #include "caf/buffered_scatterer.hpp"
 
 namespace caf {
@@ -40,16 +42,27 @@ public:
   }
 
   void emit_batches() override {
-    CAF_LOG_TRACE("");
-    auto chunk = this->get_chunk(this->min_credit());
-    auto csize = static_cast<long>(chunk.size());
-    CAF_LOG_TRACE(CAF_ARG(chunk));
-    if (csize == 0)
-      return;
-    auto wrapped_chunk = make_message(std::move(chunk));
-    for (auto& x : this->paths_) {
-      CAF_ASSERT(x->open_credit >= csize);
-      x->emit_batch(csize, wrapped_chunk);
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    emit_batches_impl(true);
+  }
+
+protected:
+  void emit_batches_impl(bool force) {
+    CAF_LOG_TRACE(CAF_ARG(force));
+    auto threshold = this->batch_threshold(force);
+    auto limit = this->batch_limit();
+    for (;;) {
+      auto n = std::min({this->min_credit(), this->buffered(), limit});
+      if (n <= 0 || n < threshold)
+        return;
+      auto batch = this->make_batch(n);
+      for (auto& x : this->paths_) {
+        CAF_ASSERT(x->open_credit >= n);
+        x->emit_batch(n, batch);
+      }
     }
   }
 };
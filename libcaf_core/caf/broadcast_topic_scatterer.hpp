@@ -24,6 +24,7 @@
 #include <tuple>
 #include <deque>
 #include <vector>
+#include <algorithm>
 #include <functional>
 
 #include "caf/topic_scatterer.hpp"
@@ -49,18 +50,31 @@ public:
   }
 
   void emit_batches() override {
-    CAF_LOG_TRACE("");
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    emit_batches_impl(true);
+  }
+
+protected:
+  void emit_batches_impl(bool force) {
+    CAF_LOG_TRACE(CAF_ARG(force));
     this->fan_out();
+    auto threshold = this->batch_threshold(force);
+    auto limit = this->batch_limit();
     for (auto& kvp : this->lanes_) {
       auto& l = kvp.second;
-      auto chunk = super::get_chunk(l.buf, super::min_credit(l.paths));
-      auto csize = static_cast<long>(chunk.size());
-      if (csize == 0)
-        continue;
-      auto wrapped_chunk = make_message(std::move(chunk));
-      for (auto& x : l.paths) {
-        CAF_ASSERT(x->open_credit >= csize);
-        x->emit_batch(csize, wrapped_chunk);
+      for (;;) {
+        auto n = std::min({super::min_credit(l.paths),
+                           static_cast<long>(l.buf.size()), limit});
+        if (n <= 0 || n < threshold)
+          break;
+        auto batch = this->make_batch(l.buf, n);
+        for (auto& x : l.paths) {
+          CAF_ASSERT(x->open_credit >= n);
+          x->emit_batch(n, batch);
+        }
       }
     }
   }
@@ -20,16 +20,20 @@
 #ifndef CAF_MIXIN_BUFFERED_SCATTERER_HPP
 #define CAF_MIXIN_BUFFERED_SCATTERER_HPP
 
-#include <deque>
 #include <vector>
 #include <cstddef>
 #include <iterator>
+#include <algorithm>
 
 #include "caf/sec.hpp"
+#include "caf/message.hpp"
+#include "caf/make_message.hpp"
 #include "caf/stream_edge_impl.hpp"
 #include "caf/actor_control_block.hpp"
 #include "caf/stream_scatterer_impl.hpp"
 
+#include "caf/detail/ring_buffer.hpp"
+
 namespace caf {
 
 /// Mixin for streams with any number of downstreams. `Subtype` must provide a
@@ -41,10 +45,13 @@ public:
 
   using value_type = T;
 
-  using buffer_type = std::deque<value_type>;
+  using buffer_type = detail::ring_buffer<value_type>;
 
   using chunk_type = std::vector<value_type>;
 
+  /// Maximum number of emitted batches we keep around for recycling.
+  static constexpr size_t max_recycled_batches = 8;
+
   buffered_scatterer(local_actor* selfptr) : super(selfptr) {
     // nop
   }
@@ -60,15 +67,7 @@ public:
     chunk_type xs;
     if (n > 0) {
       xs.reserve(static_cast<size_t>(n));
-      if (static_cast<size_t>(n) < buf.size()) {
-        auto first = buf.begin();
-        auto last = first + static_cast<ptrdiff_t>(n);
-        std::move(first, last, std::back_inserter(xs));
-        buf.erase(first, last);
-      } else {
-        std::move(buf.begin(), buf.end(), std::back_inserter(xs));
-        buf.clear();
-      }
+      buf.move_front(static_cast<size_t>(n), std::back_inserter(xs));
     }
     return xs;
   }
@@ -77,6 +76,34 @@ public:
     return get_chunk(buf_, n);
   }
 
+  /// Moves `n` elements from `buf` into a batch message. Reuses the memory
+  /// of a previously emitted batch if all receivers have released it, i.e.,
+  /// emitting batches at a steady rate eventually stops allocating.
+  /// @pre `n <= buf.size()`
+  message make_batch(buffer_type& buf, long n) {
+    CAF_LOG_TRACE(CAF_ARG(n));
+    auto released = [](const message& x) {
+      return x.cvals()->unique();
+    };
+    auto i = std::find_if(recycled_.begin(), recycled_.end(), released);
+    if (i == recycled_.end()) {
+      auto result = make_message(get_chunk(buf, n));
+      if (recycled_.size() < max_recycled_batches)
+        recycled_.push_back(result);
+      return result;
+    }
+    // we hold the only reference, hence get_mutable_as won't copy
+    auto& xs = i->template get_mutable_as<chunk_type>(0);
+    xs.clear();
+    if (n > 0)
+      buf.move_front(static_cast<size_t>(n), std::back_inserter(xs));
+    return *i;
+  }
+
+  message make_batch(long n) {
+    return make_batch(buf_, n);
+  }
+
   long buffered() const override {
     return static_cast<long>(buf_.size());
   }
@@ -91,6 +118,9 @@ public:
 
 protected:
   buffer_type buf_;
+
+  /// Stores previously emitted batches for reusing their memory.
+  std::vector<message> recycled_;
 };
 
 } // namespace caf
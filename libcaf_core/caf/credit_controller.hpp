@@ -0,0 +1,65 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_CREDIT_CONTROLLER_HPP
+#define CAF_CREDIT_CONTROLLER_HPP
+
+#include "caf/fwd.hpp"
+#include "caf/timestamp.hpp"
+
+namespace caf {
+
+/// Computes how much credit a gatherer grants to a single source. Each
+/// `inbound_path` owns one controller and reports to it after processing a
+/// batch. The gatherer caps credit on the path at `max_credit()` and only
+/// sends new credit in chunks of at least `batch_size()` (unless the path
+/// ran dry), which in turn controls the size of batches produced upstream.
+class credit_controller {
+public:
+  virtual ~credit_controller();
+
+  /// Updates the statistics of this controller after processing a batch.
+  /// @param num_elements Number of elements in the batch.
+  /// @param processing_time Time spent for processing the batch.
+  /// @param latency Time between granting credit and receiving the batch.
+  virtual void batch_processed(long num_elements, timespan processing_time,
+                               timespan latency) = 0;
+
+  /// Returns the maximum amount of credit for the path.
+  virtual long max_credit() const = 0;
+
+  /// Returns the minimum amount of credit for a single credit assignment.
+  virtual long batch_size() const = 0;
+
+  /// Returns whether this controller uses measurements. Stream managers only
+  /// take timestamps and call `batch_processed` if this returns `true`.
+  inline bool measures() const {
+    return measures_;
+  }
+
+protected:
+  explicit credit_controller(bool measures = true);
+
+private:
+  bool measures_;
+};
+
+} // namespace caf
+
+#endif // CAF_CREDIT_CONTROLLER_HPP
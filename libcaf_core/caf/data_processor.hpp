@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <string>
+#include <algorithm>
 #include <cstdint>
 #include <cstddef> // size_t
 #include <type_traits>
@@ -261,6 +262,20 @@ public:
     return convert_apply(dref(), x, tmp, assign);
   }
 
+  /// Applies this processor to a vector of integers or floating point
+  /// numbers, processing all elements at once via `apply_builtin_array`.
+  template <class T>
+  typename std::enable_if<
+    std::is_arithmetic<T>::value
+    && !std::is_same<bool, T>::value
+    && !std::is_same<long double, T>::value
+    && !detail::is_byte_sequence<std::vector<T>>::value,
+    error
+  >::type
+  apply(std::vector<T>& xs) {
+    return apply_builtin_sequence(dref(), xs);
+  }
+
   template <class T>
   error consume_range(T& xs) {
     for (auto& x : xs) {
@@ -366,6 +381,65 @@ public:
                        [&] { return self.end_sequence(); });
   }
 
+  // Returns the builtin type tag for the arithmetic type `T`.
+  template <class T>
+  static builtin builtin_type_of() {
+    using type =
+      typename std::conditional<
+        std::is_floating_point<T>::value,
+        T,
+        typename detail::select_integer_type<
+          static_cast<int>(sizeof(T)) * (std::is_signed<T>::value ? -1 : 1)
+        >::type
+      >::type;
+    static constexpr auto tlindex = detail::tl_index_of<builtin_t, type>::value;
+    static_assert(tlindex >= 0, "T not recognized as builtin type");
+    return static_cast<builtin>(tlindex);
+  }
+
+  // Applies this processor as Derived to a vector of arithmetic values in
+  // saving mode.
+  template <class D, class T>
+  static typename std::enable_if<D::reads_state, error>::type
+  apply_builtin_sequence(D& self, std::vector<T>& xs) {
+    auto s = xs.size();
+    auto& dp = static_cast<data_processor&>(self);
+    return error::eval([&] { return self.begin_sequence(s); },
+                       [&] { return s > 0
+                                    ? dp.apply_builtin_array(
+                                        builtin_type_of<T>(), s, xs.data())
+                                    : none; },
+                       [&] { return self.end_sequence(); });
+  }
+
+  // Applies this processor as Derived to a vector of arithmetic values in
+  // loading mode.
+  template <class D, class T>
+  static typename std::enable_if<!D::reads_state, error>::type
+  apply_builtin_sequence(D& self, std::vector<T>& xs) {
+    size_t s;
+    auto& dp = static_cast<data_processor&>(self);
+    // Grow the vector in bounded steps, since `s` comes from untrusted input
+    // and may exceed the remaining bytes by far.
+    auto load = [&]() -> error {
+      static constexpr size_t max_chunk = 4096;
+      xs.clear();
+      while (xs.size() < s) {
+        auto n = std::min(s - xs.size(), max_chunk);
+        auto offset = xs.size();
+        xs.resize(offset + n);
+        auto err = dp.apply_builtin_array(builtin_type_of<T>(), n,
+                                          xs.data() + offset);
+        if (err)
+          return err;
+      }
+      return none;
+    };
+    return error::eval([&] { return self.begin_sequence(s); },
+                       load,
+                       [&] { return self.end_sequence(); });
+  }
+
   /// Applies this processor to a sequence of values.
   template <class T>
   typename std::enable_if<
@@ -552,6 +626,27 @@ protected:
   /// Applies this processor to a single builtin value.
   virtual error apply_builtin(builtin in_out_type, void* in_out) = 0;
 
+  /// Applies this processor to `num` consecutive values of the arithmetic
+  /// type `in_out_type`. The default implementation calls `apply_builtin`
+  /// for each value.
+  virtual error apply_builtin_array(builtin in_out_type, size_t num,
+                                    void* in_out) {
+    static constexpr size_t sizes[] = {
+      sizeof(int8_t), sizeof(uint8_t), sizeof(int16_t), sizeof(uint16_t),
+      sizeof(int32_t), sizeof(uint32_t), sizeof(int64_t), sizeof(uint64_t),
+      sizeof(float), sizeof(double)
+    };
+    CAF_ASSERT(in_out_type <= double_v);
+    auto stride = sizes[in_out_type];
+    auto ptr = reinterpret_cast<char*>(in_out);
+    for (size_t i = 0; i < num; ++i) {
+      auto e = apply_builtin(in_out_type, ptr + i * stride);
+      if (e)
+        return e;
+    }
+    return none;
+  }
+
 private:
   template <class T>
   T& deconst(const T& x) {
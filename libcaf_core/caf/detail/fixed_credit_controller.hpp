@@ -0,0 +1,50 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_FIXED_CREDIT_CONTROLLER_HPP
+#define CAF_DETAIL_FIXED_CREDIT_CONTROLLER_HPP
+
+#include "caf/credit_controller.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Grants credit according to the static `max_credit` and
+/// `min_credit_assignment` parameters of a gatherer, ignoring measurements.
+class fixed_credit_controller : public credit_controller {
+public:
+  explicit fixed_credit_controller(const stream_gatherer* parent);
+
+  ~fixed_credit_controller() override;
+
+  void batch_processed(long num_elements, timespan processing_time,
+                       timespan latency) override;
+
+  long max_credit() const override;
+
+  long batch_size() const override;
+
+private:
+  const stream_gatherer* parent_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_FIXED_CREDIT_CONTROLLER_HPP
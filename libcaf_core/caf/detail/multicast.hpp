@@ -0,0 +1,71 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_MULTICAST_HPP
+#define CAF_DETAIL_MULTICAST_HPP
+
+#include <vector>
+#include <utility>
+
+#include "caf/fwd.hpp"
+#include "caf/actor.hpp"
+#include "caf/message.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Groups a set of receivers by their manager once in order to send any
+/// number of messages to them without repeating the lookups. Instead of
+/// forwarding one message per remote receiver, proxies sharing the same
+/// manager (i.e., the BASP broker) receive a single
+/// `(multicast_atom, sender, receivers, msg)` message. This allows the
+/// manager to serialize `msg` only once and then send it once per receiving
+/// node.
+class multicast_plan {
+public:
+  multicast_plan() = default;
+
+  explicit multicast_plan(const std::vector<strong_actor_ptr>& receivers);
+
+  /// Sends `msg` to all receivers.
+  void send(const strong_actor_ptr& sender, const message& msg,
+            execution_unit* host) const;
+
+  /// Returns whether this plan has no receivers.
+  inline bool empty() const {
+    return direct_.empty() && bundles_.empty();
+  }
+
+private:
+  using bundle = std::pair<actor, std::vector<strong_actor_ptr>>;
+
+  std::vector<strong_actor_ptr> direct_;
+  std::vector<bundle> bundles_;
+};
+
+/// Sends `msg` to all `receivers` without caching the plan.
+void multicast(const strong_actor_ptr& sender,
+               const std::vector<strong_actor_ptr>& receivers,
+               const message& msg, execution_unit* host);
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_MULTICAST_HPP
@@ -0,0 +1,281 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_POOL_POLICIES_HPP
+#define CAF_DETAIL_POOL_POLICIES_HPP
+
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+#include "caf/actor.hpp"
+#include "caf/execution_unit.hpp"
+#include "caf/mailbox_element.hpp"
+
+#include "caf/detail/rcu_ptr.hpp"
+
+namespace caf {
+namespace detail {
+
+// Built-in dispatching policies for `actor_pool`. All policies are called
+// concurrently by any number of senders, never allocate, and never block.
+// Each policy receives a non-empty snapshot of the current workers.
+// Policies providing a member function `workers_changed(const vector<actor>&)`
+// get notified by the pool whenever its set of workers changes.
+
+/// Scrambles the bits of `x` using the SplitMix64 finalizer.
+inline uint64_t mix64(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+/// Dispatches each message to the next worker in line.
+class round_robin_policy {
+public:
+  round_robin_policy() : pos_(0) {
+    // nop
+  }
+
+  round_robin_policy(const round_robin_policy&) : pos_(0) {
+    // nop
+  }
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto i = pos_.fetch_add(1, std::memory_order_relaxed);
+    workers[i % workers.size()]->enqueue(std::move(ptr), host);
+  }
+
+private:
+  std::atomic<size_t> pos_;
+};
+
+/// Dispatches each message to all workers.
+class broadcast_policy {
+public:
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto msg = ptr->move_content_to_message();
+    for (auto& worker : workers)
+      worker->enqueue(ptr->sender, ptr->mid, msg, host);
+  }
+};
+
+/// Dispatches each message to a randomly chosen worker. Uses the
+/// SplitMix64 generator on an atomic state in order to avoid locking.
+class random_policy {
+public:
+  random_policy();
+
+  random_policy(const random_policy&);
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto x = mix64(state_.fetch_add(0x9E3779B97F4A7C15ull,
+                                    std::memory_order_relaxed));
+    workers[x % workers.size()]->enqueue(std::move(ptr), host);
+  }
+
+private:
+  std::atomic<uint64_t> state_;
+};
+
+/// Enables `abstract_actor::mailbox_size_hint` for all workers.
+void track_mailbox_sizes(const std::vector<actor>& workers);
+
+/// Dispatches each message to the worker with the fewest messages in its
+/// mailbox according to `abstract_actor::mailbox_size_hint`. The scan starts
+/// at a rotating index and stops at the first idle worker, i.e., idle
+/// workers receive messages in round-robin order.
+class least_loaded_policy {
+public:
+  least_loaded_policy() : pos_(0) {
+    // nop
+  }
+
+  least_loaded_policy(const least_loaded_policy&) : pos_(0) {
+    // nop
+  }
+
+  void workers_changed(const std::vector<actor>& workers) {
+    track_mailbox_sizes(workers);
+  }
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto n = workers.size();
+    auto first = pos_.fetch_add(1, std::memory_order_relaxed) % n;
+    auto selected = first;
+    auto min_load = workers[first]->mailbox_size_hint();
+    for (size_t i = 1; i < n && min_load > 0; ++i) {
+      auto j = (first + i) % n;
+      auto load = workers[j]->mailbox_size_hint();
+      if (load < min_load) {
+        selected = j;
+        min_load = load;
+      }
+    }
+    workers[selected]->enqueue(std::move(ptr), host);
+  }
+
+private:
+  std::atomic<size_t> pos_;
+};
+
+/// Samples two distinct workers at random and dispatches each message to the
+/// one with fewer messages in its mailbox ("power of two choices"). Compared
+/// to `least_loaded_policy`, this policy runs in constant time and avoids
+/// herding all senders onto the same worker when load hints are stale.
+class power_of_two_policy {
+public:
+  power_of_two_policy();
+
+  power_of_two_policy(const power_of_two_policy&);
+
+  void workers_changed(const std::vector<actor>& workers) {
+    track_mailbox_sizes(workers);
+  }
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto n = workers.size();
+    if (n == 1) {
+      workers.front()->enqueue(std::move(ptr), host);
+      return;
+    }
+    auto x = mix64(state_.fetch_add(0x9E3779B97F4A7C15ull,
+                                    std::memory_order_relaxed));
+    // pick two distinct indexes from the lower and upper 32 bits
+    auto i = static_cast<size_t>(x & 0xFFFFFFFFull) % n;
+    auto j = (i + 1 + static_cast<size_t>(x >> 32) % (n - 1)) % n;
+    auto& selected = workers[i]->mailbox_size_hint()
+                     <= workers[j]->mailbox_size_hint() ? workers[i]
+                                                        : workers[j];
+    selected->enqueue(std::move(ptr), host);
+  }
+
+private:
+  std::atomic<uint64_t> state_;
+};
+
+/// Maps `key` to one of `num_buckets` buckets, moving only `1 / num_buckets`
+/// of all keys when appending a bucket (Lamping and Veach: "A Fast, Minimal
+/// Memory, Consistent Hash Algorithm").
+size_t jump_consistent_hash(uint64_t key, size_t num_buckets);
+
+/// Dispatches each message to a worker selected by hashing a key extracted
+/// from the message. Scrambles the hash value before selecting a worker,
+/// since `std::hash` is the identity function for integers on most
+/// platforms. Messages with the same key always go to the same
+/// worker as long as the set of workers remains unchanged.
+/// @tparam KeyFn Function object with signature `T (const type_erased_tuple&)`
+///               for any `T` with a specialization of `std::hash`.
+template <class KeyFn>
+class key_hash_policy {
+public:
+  explicit key_hash_policy(KeyFn f) : f_(std::move(f)) {
+    // nop
+  }
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto key = f_(ptr->content());
+    std::hash<typename std::decay<decltype(key)>::type> h;
+    auto i = jump_consistent_hash(mix64(h(key)), workers.size());
+    workers[i]->enqueue(std::move(ptr), host);
+  }
+
+private:
+  KeyFn f_;
+};
+
+/// Sorted list of (hash, worker) pairs forming a consistent hash ring.
+using hash_ring = std::vector<std::pair<uint64_t, actor>>;
+
+/// Builds a hash ring placing `virtual_nodes` points per worker. The position
+/// of each point depends only on the worker itself, i.e., adding or removing
+/// a worker leaves the points of all other workers in place.
+hash_ring make_hash_ring(const std::vector<actor>& workers,
+                         size_t virtual_nodes);
+
+/// Returns the first worker at or after `key` on the non-empty ring `xs`.
+const actor& hash_ring_lookup(const hash_ring& xs, uint64_t key);
+
+/// Dispatches each message to a worker selected by looking up a key extracted
+/// from the message on a consistent hash ring with virtual nodes. Adding or
+/// removing a worker only moves the keys of its own ring segments, i.e.,
+/// roughly `1 / n` of all keys for `n` workers.
+/// @tparam KeyFn Function object with signature `T (const type_erased_tuple&)`
+///               for any `T` with a specialization of `std::hash`.
+template <class KeyFn>
+class consistent_hash_policy {
+public:
+  consistent_hash_policy(KeyFn f, size_t virtual_nodes)
+      : f_(std::move(f)),
+        virtual_nodes_(virtual_nodes > 0 ? virtual_nodes : 1) {
+    // nop
+  }
+
+  consistent_hash_policy(const consistent_hash_policy& other)
+      : f_(other.f_),
+        virtual_nodes_(other.virtual_nodes_),
+        ring_(*other.ring_.read()) {
+    // nop
+  }
+
+  void workers_changed(const std::vector<actor>& workers) {
+    ring_.reset(make_hash_ring(workers, virtual_nodes_));
+  }
+
+  void operator()(actor_system&, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
+    CAF_ASSERT(!workers.empty());
+    auto key = f_(ptr->content());
+    std::hash<typename std::decay<decltype(key)>::type> h;
+    auto x = mix64(h(key));
+    auto ring = ring_.read();
+    // the ring can lag behind the snapshot while the pool removes its
+    // last worker; fall back to hashing on the snapshot in this case
+    if (ring->empty())
+      workers[jump_consistent_hash(x, workers.size())]->enqueue(std::move(ptr),
+                                                                host);
+    else
+      hash_ring_lookup(*ring, x)->enqueue(std::move(ptr), host);
+  }
+
+private:
+  KeyFn f_;
+  size_t virtual_nodes_;
+  rcu_ptr<hash_ring> ring_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_POOL_POLICIES_HPP
@@ -0,0 +1,164 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_RCU_PTR_HPP
+#define CAF_DETAIL_RCU_PTR_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Owns an immutable value of type `T` following the read-copy-update idiom.
+/// Readers never block and never wait for writers. Writers modify a private
+/// copy, publish it atomically and then wait until all readers of the
+/// previous value are gone (grace period) before destroying the old copy.
+/// This makes `rcu_ptr` a good fit for read-mostly data such as the workers
+/// of an actor pool, where updates are rare but reads happen per message.
+template <class T>
+class rcu_ptr {
+public:
+  /// Pins the value that was current at construction time.
+  class reader {
+  public:
+    reader(reader&& other) : counter_(other.counter_), ptr_(other.ptr_) {
+      other.counter_ = nullptr;
+    }
+
+    reader(const reader&) = delete;
+    reader& operator=(const reader&) = delete;
+
+    ~reader() {
+      if (counter_)
+        counter_->fetch_sub(1, std::memory_order_release);
+    }
+
+    const T& operator*() const {
+      return *ptr_;
+    }
+
+    const T* operator->() const {
+      return ptr_;
+    }
+
+    const T* get() const {
+      return ptr_;
+    }
+
+  private:
+    friend class rcu_ptr;
+
+    reader(std::atomic<size_t>* counter, const T* ptr)
+        : counter_(counter),
+          ptr_(ptr) {
+      // nop
+    }
+
+    std::atomic<size_t>* counter_;
+    const T* ptr_;
+  };
+
+  explicit rcu_ptr(T value = T{}) : value_(new T(std::move(value))), epoch_(0) {
+    readers_[0] = 0;
+    readers_[1] = 0;
+  }
+
+  rcu_ptr(const rcu_ptr&) = delete;
+  rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+  ~rcu_ptr() {
+    delete value_.load();
+  }
+
+  /// Returns a handle to the current value.
+  /// @threadsafe
+  reader read() const {
+    // Register in the counter of the current epoch. Re-checking the epoch
+    // after the increment guarantees that any writer flipping the epoch
+    // afterwards waits for us.
+    for (;;) {
+      auto e = epoch_.load();
+      auto& counter = readers_[e];
+      counter.fetch_add(1);
+      if (epoch_.load() == e)
+        return {&counter, value_.load()};
+      counter.fetch_sub(1);
+    }
+  }
+
+  /// Applies `f` to a copy of the current value and publishes the result.
+  /// Returns after all readers of the previous value are done.
+  /// @threadsafe
+  /// @warning Must not be called while holding a `reader` of this object.
+  template <class F>
+  void update(F f) {
+    std::unique_lock<std::mutex> guard{writer_mtx_};
+    T* cpy = new T(*value_.load());
+    f(*cpy);
+    publish(cpy);
+  }
+
+  /// Replaces the current value with `x`.
+  /// @threadsafe
+  /// @warning Must not be called while holding a `reader` of this object.
+  void reset(T x) {
+    std::unique_lock<std::mutex> guard{writer_mtx_};
+    publish(new T(std::move(x)));
+  }
+
+private:
+  // Requires `writer_mtx_` to be locked.
+  void publish(T* x) {
+    auto old = value_.exchange(x);
+    auto e = epoch_.load();
+    epoch_.store(e ^ 1);
+    // New readers register for the new epoch, i.e., the counter for the old
+    // epoch only drops. Readers can hold on to a value for a while, so we
+    // back off exponentially after spinning briefly instead of burning CPU
+    // cycles the readers need in order to make progress.
+    size_t spins = 0;
+    auto delay = std::chrono::microseconds(1);
+    while (readers_[e].load(std::memory_order_acquire) != 0) {
+      if (++spins < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(delay);
+        if (delay < std::chrono::milliseconds(1))
+          delay *= 2;
+      }
+    }
+    delete old;
+  }
+
+  std::atomic<T*> value_;
+  std::atomic<size_t> epoch_;
+  mutable std::atomic<size_t> readers_[2];
+  std::mutex writer_mtx_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_RCU_PTR_HPP
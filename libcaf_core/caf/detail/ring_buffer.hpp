@@ -0,0 +1,540 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_RING_BUFFER_HPP
+#define CAF_DETAIL_RING_BUFFER_HPP
+
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A growable FIFO queue storing its elements in a single contiguous block of
+/// memory. In contrast to `std::deque`, consuming elements from the front
+/// never releases memory and appending elements only allocates when the
+/// queue runs out of capacity. Hence, a `ring_buffer` that is filled and
+/// drained at a steady rate stops allocating once it reached its peak size.
+template <class T>
+class ring_buffer {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = T;
+
+  using size_type = size_t;
+
+  using difference_type = ptrdiff_t;
+
+  using reference = T&;
+
+  using const_reference = const T&;
+
+  using pointer = T*;
+
+  using const_pointer = const T*;
+
+  /// Random access iterator over a `ring_buffer`.
+  template <class Buffer, class Value>
+  class iterator_impl {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+
+    using value_type = typename std::remove_const<Value>::type;
+
+    using difference_type = ptrdiff_t;
+
+    using pointer = Value*;
+
+    using reference = Value&;
+
+    iterator_impl() : buf_(nullptr), pos_(0) {
+      // nop
+    }
+
+    iterator_impl(Buffer* buf, size_t pos) : buf_(buf), pos_(pos) {
+      // nop
+    }
+
+    template <class B, class V>
+    iterator_impl(const iterator_impl<B, V>& other)
+        : buf_(other.buf_),
+          pos_(other.pos_) {
+      // nop
+    }
+
+    reference operator*() const {
+      return (*buf_)[pos_];
+    }
+
+    pointer operator->() const {
+      return &(*buf_)[pos_];
+    }
+
+    reference operator[](difference_type n) const {
+      return (*buf_)[static_cast<size_t>(static_cast<difference_type>(pos_)
+                                         + n)];
+    }
+
+    iterator_impl& operator++() {
+      ++pos_;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      auto result = *this;
+      ++pos_;
+      return result;
+    }
+
+    iterator_impl& operator--() {
+      --pos_;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      auto result = *this;
+      --pos_;
+      return result;
+    }
+
+    iterator_impl& operator+=(difference_type n) {
+      pos_ = static_cast<size_t>(static_cast<difference_type>(pos_) + n);
+      return *this;
+    }
+
+    iterator_impl& operator-=(difference_type n) {
+      return *this += -n;
+    }
+
+    friend iterator_impl operator+(iterator_impl x, difference_type n) {
+      return x += n;
+    }
+
+    friend iterator_impl operator+(difference_type n, iterator_impl x) {
+      return x += n;
+    }
+
+    friend iterator_impl operator-(iterator_impl x, difference_type n) {
+      return x -= n;
+    }
+
+    friend difference_type operator-(const iterator_impl& x,
+                                     const iterator_impl& y) {
+      return static_cast<difference_type>(x.pos_)
+             - static_cast<difference_type>(y.pos_);
+    }
+
+    friend bool operator==(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ == y.pos_;
+    }
+
+    friend bool operator!=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ != y.pos_;
+    }
+
+    friend bool operator<(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ < y.pos_;
+    }
+
+    friend bool operator>(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ > y.pos_;
+    }
+
+    friend bool operator<=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ <= y.pos_;
+    }
+
+    friend bool operator>=(const iterator_impl& x, const iterator_impl& y) {
+      return x.pos_ >= y.pos_;
+    }
+
+  private:
+    template <class, class>
+    friend class iterator_impl;
+
+    Buffer* buf_;
+    size_t pos_;
+  };
+
+  using iterator = iterator_impl<ring_buffer, T>;
+
+  using const_iterator = iterator_impl<const ring_buffer, const T>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ring_buffer() : buf_(nullptr), capacity_(0), first_(0), size_(0) {
+    // nop
+  }
+
+  ring_buffer(const ring_buffer& other) : ring_buffer() {
+    reserve(other.size_);
+    for (auto& x : other)
+      push_back(x);
+  }
+
+  ring_buffer(ring_buffer&& other) noexcept
+      : buf_(other.buf_),
+        capacity_(other.capacity_),
+        first_(other.first_),
+        size_(other.size_) {
+    other.buf_ = nullptr;
+    other.capacity_ = 0;
+    other.first_ = 0;
+    other.size_ = 0;
+  }
+
+  ring_buffer& operator=(ring_buffer other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~ring_buffer() {
+    clear();
+    if (buf_ != nullptr)
+      alloc_.deallocate(buf_, capacity_);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the number of elements this buffer can store without allocating.
+  size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  // -- element access ---------------------------------------------------------
+
+  T& operator[](size_t pos) {
+    CAF_ASSERT(pos < size_);
+    return buf_[index(pos)];
+  }
+
+  const T& operator[](size_t pos) const {
+    CAF_ASSERT(pos < size_);
+    return buf_[index(pos)];
+  }
+
+  T& front() {
+    return (*this)[0];
+  }
+
+  const T& front() const {
+    return (*this)[0];
+  }
+
+  T& back() {
+    return (*this)[size_ - 1];
+  }
+
+  const T& back() const {
+    return (*this)[size_ - 1];
+  }
+
+  // -- iterator access --------------------------------------------------------
+
+  iterator begin() {
+    return {this, 0};
+  }
+
+  const_iterator begin() const {
+    return {this, 0};
+  }
+
+  const_iterator cbegin() const {
+    return begin();
+  }
+
+  iterator end() {
+    return {this, size_};
+  }
+
+  const_iterator end() const {
+    return {this, size_};
+  }
+
+  const_iterator cend() const {
+    return end();
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Makes sure the buffer can store at least `n` elements without
+  /// allocating. Rounds the capacity up to the next power of two. Leaves the
+  /// buffer unchanged if allocating or moving an element throws.
+  void reserve(size_t n) {
+    if (n <= capacity_)
+      return;
+    storage tmp{alloc_, grown_capacity(n)};
+    relocate(tmp, 0);
+    adopt(tmp);
+  }
+
+  template <class... Ts>
+  void emplace_back(Ts&&... xs) {
+    if (size_ < capacity_) {
+      ::new (buf_ + index(size_)) T(std::forward<Ts>(xs)...);
+      ++size_;
+      return;
+    }
+    // Construct the new element before moving the others, since `xs` may
+    // refer to an element of this buffer, e.g., `xs.push_back(xs.front())`.
+    storage tmp{alloc_, grown_capacity(size_ + 1)};
+    tmp.construct_extra(size_, std::forward<Ts>(xs)...);
+    relocate(tmp, 0);
+    adopt(tmp);
+    ++size_;
+  }
+
+  void push_back(const T& x) {
+    emplace_back(x);
+  }
+
+  void push_back(T&& x) {
+    emplace_back(std::move(x));
+  }
+
+  template <class... Ts>
+  void emplace_front(Ts&&... xs) {
+    if (size_ < capacity_) {
+      auto pos = (first_ + capacity_ - 1) & (capacity_ - 1);
+      ::new (buf_ + pos) T(std::forward<Ts>(xs)...);
+      first_ = pos;
+      ++size_;
+      return;
+    }
+    storage tmp{alloc_, grown_capacity(size_ + 1)};
+    tmp.construct_extra(0, std::forward<Ts>(xs)...);
+    relocate(tmp, 1);
+    adopt(tmp);
+    ++size_;
+  }
+
+  void push_front(const T& x) {
+    emplace_front(x);
+  }
+
+  void push_front(T&& x) {
+    emplace_front(std::move(x));
+  }
+
+  /// Inserts `x` before `pos`. Inserting at the end runs in constant time,
+  /// inserting anywhere else in linear time.
+  iterator insert(const_iterator pos, T x) {
+    auto offset = pos - cbegin();
+    emplace_back(std::move(x));
+    auto first = begin() + offset;
+    std::rotate(first, end() - 1, end());
+    return first;
+  }
+
+  /// Removes the elements in the range `[first, last)` and returns an
+  /// iterator to the element following the removed ones.
+  iterator erase(const_iterator first, const_iterator last) {
+    auto offset = first - cbegin();
+    auto n = static_cast<size_t>(last - first);
+    if (n == 0)
+      return begin() + offset;
+    if (offset == 0) {
+      drop_front(n);
+      return begin();
+    }
+    auto pos = begin() + offset;
+    std::move(pos + static_cast<difference_type>(n), end(), pos);
+    for (size_t i = size_ - n; i < size_; ++i)
+      buf_[index(i)].~T();
+    size_ -= n;
+    return begin() + offset;
+  }
+
+  /// Removes the element at `pos` and returns an iterator to the element
+  /// following it.
+  iterator erase(const_iterator pos) {
+    return erase(pos, pos + 1);
+  }
+
+  /// Destroys the first element.
+  /// @pre `!empty()`
+  void pop_front() {
+    drop_front(1);
+  }
+
+  /// Destroys the last element.
+  /// @pre `!empty()`
+  void pop_back() {
+    CAF_ASSERT(size_ > 0);
+    buf_[index(size_ - 1)].~T();
+    if (--size_ == 0)
+      first_ = 0;
+  }
+
+  /// Destroys the first `n` elements.
+  /// @pre `n <= size()`
+  void drop_front(size_t n) {
+    CAF_ASSERT(n <= size_);
+    for (size_t i = 0; i < n; ++i)
+      buf_[index(i)].~T();
+    size_ -= n;
+    first_ = size_ > 0 ? index(n) : 0;
+  }
+
+  /// Moves the first `n` elements to `out` and removes them afterwards.
+  /// @pre `n <= size()`
+  template <class OutputIterator>
+  OutputIterator move_front(size_t n, OutputIterator out) {
+    CAF_ASSERT(n <= size_);
+    for (size_t i = 0; i < n; ++i)
+      *out++ = std::move(buf_[index(i)]);
+    drop_front(n);
+    return out;
+  }
+
+  /// Destroys all elements but keeps the allocated memory.
+  void clear() {
+    drop_front(size_);
+  }
+
+  void swap(ring_buffer& other) noexcept {
+    using std::swap;
+    swap(buf_, other.buf_);
+    swap(capacity_, other.capacity_);
+    swap(first_, other.first_);
+    swap(size_, other.size_);
+  }
+
+private:
+  // Owns a new block of memory until the buffer adopts it. Destroys all
+  // elements constructed so far and releases the memory if an exception
+  // occurs before that.
+  class storage {
+  public:
+    storage(std::allocator<T>& alloc, size_t capacity)
+        : alloc_(alloc),
+          buf_(alloc.allocate(capacity)),
+          capacity_(capacity),
+          first_(0),
+          size_(0),
+          extra_(nullptr) {
+      // nop
+    }
+
+    storage(const storage&) = delete;
+    storage& operator=(const storage&) = delete;
+
+    ~storage() {
+      if (buf_ == nullptr)
+        return;
+      for (size_t i = 0; i < size_; ++i)
+        buf_[first_ + i].~T();
+      if (extra_ != nullptr)
+        extra_->~T();
+      alloc_.deallocate(buf_, capacity_);
+    }
+
+    // Constructs an element at `pos` outside of the relocated range.
+    template <class... Ts>
+    void construct_extra(size_t pos, Ts&&... xs) {
+      ::new (buf_ + pos) T(std::forward<Ts>(xs)...);
+      extra_ = buf_ + pos;
+    }
+
+    // Constructs the next relocated element, starting at `first`.
+    template <class U>
+    void append(size_t first, U&& x) {
+      first_ = first;
+      ::new (buf_ + first_ + size_) T(std::forward<U>(x));
+      ++size_;
+    }
+
+    T* release() {
+      auto result = buf_;
+      buf_ = nullptr;
+      return result;
+    }
+
+    size_t capacity() const {
+      return capacity_;
+    }
+
+  private:
+    std::allocator<T>& alloc_;
+    T* buf_;
+    size_t capacity_;
+    size_t first_;
+    size_t size_;
+    T* extra_;
+  };
+
+  // Maps a logical position to a physical position in `buf_`.
+  size_t index(size_t pos) const {
+    return (first_ + pos) & (capacity_ - 1);
+  }
+
+  // Returns the capacity after growing to at least `n` elements.
+  size_t grown_capacity(size_t n) const {
+    size_t result = capacity_ > 0 ? capacity_ : 16;
+    while (result < n)
+      result *= 2;
+    return result;
+  }
+
+  // Moves all elements to `dst`, starting at `first`. Copies elements with a
+  // throwing move constructor (like `std::vector`) in order to leave this
+  // buffer unchanged if an exception occurs.
+  void relocate(storage& dst, size_t first) {
+    for (size_t i = 0; i < size_; ++i)
+      dst.append(first, std::move_if_noexcept(buf_[index(i)]));
+  }
+
+  // Replaces the current memory block with `src`.
+  void adopt(storage& src) {
+    auto new_capacity = src.capacity();
+    auto new_buf = src.release();
+    for (size_t i = 0; i < size_; ++i)
+      buf_[index(i)].~T();
+    if (buf_ != nullptr)
+      alloc_.deallocate(buf_, capacity_);
+    buf_ = new_buf;
+    capacity_ = new_capacity;
+    first_ = 0;
+  }
+
+  std::allocator<T> alloc_;
+  T* buf_;
+  size_t capacity_;
+  size_t first_;
+  size_t size_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_RING_BUFFER_HPP
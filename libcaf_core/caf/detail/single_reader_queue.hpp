@@ -70,10 +70,17 @@ public:
   /// @threadsafe
   enqueue_result enqueue(pointer new_element) {
     CAF_ASSERT(new_element != nullptr);
+    // increment before publishing the element to make sure the reader
+    // never decrements below zero
+    auto counter = size_counter_.load(std::memory_order_acquire);
+    if (counter != nullptr)
+      counter->value.fetch_add(1, std::memory_order_relaxed);
     pointer e = stack_.load();
     for (;;) {
       if (!e) {
         // if tail is nullptr, the queue has been closed
+        if (counter != nullptr)
+          counter->value.fetch_sub(1, std::memory_order_relaxed);
         delete_(new_element);
         return enqueue_result::queue_closed;
       }
@@ -147,13 +154,40 @@ public:
     cache_.clear(f);
   }
 
-  single_reader_queue() : head_(nullptr) {
+  single_reader_queue() : size_counter_(nullptr), head_(nullptr) {
     stack_ = stack_empty_dummy();
   }
 
   ~single_reader_queue() {
     if (!closed())
       close();
+    delete size_counter_.load();
+  }
+
+  /// Enables `size_hint`. Tracking the size is opt-in, since the counter
+  /// adds two atomic operations per element.
+  /// @threadsafe
+  void track_size() {
+    if (size_counter_.load() != nullptr)
+      return;
+    auto counter = new size_counter;
+    size_counter* expected = nullptr;
+    if (!size_counter_.compare_exchange_strong(expected, counter))
+      delete counter;
+  }
+
+  /// Returns an approximation of the number of elements that were enqueued
+  /// but not yet taken out of the queue or 0 if size tracking is disabled.
+  /// Elements moved to the cache by the owner do not count.
+  /// @threadsafe
+  size_t size_hint() const {
+    auto counter = size_counter_.load(std::memory_order_acquire);
+    if (counter == nullptr)
+      return 0;
+    // the counter can drop below zero for elements that were enqueued
+    // before enabling size tracking
+    auto result = counter->value.load(std::memory_order_relaxed);
+    return result > 0 ? static_cast<size_t>(result) : 0u;
   }
 
   size_t count(size_t max_count = std::numeric_limits<size_t>::max()) {
@@ -267,14 +301,32 @@ public:
   }
 
 private:
+  // Lives on its own cache line to avoid false sharing between writers
+  // updating the counter and readers accessing `stack_`.
+  struct size_counter {
+    size_counter() : value(0) {
+      // nop
+    }
+    char pad1[CAF_CACHE_LINE_SIZE];
+    std::atomic<long> value;
+    char pad2[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<long>)];
+  };
+
   // exposed to "outside" access
   std::atomic<pointer> stack_;
+  std::atomic<size_counter*> size_counter_;
 
   // accessed only by the owner
   pointer head_;
   deleter_type delete_;
   intrusive_partitioned_list<value_type, deleter_type> cache_;
 
+  void dec_size() {
+    auto counter = size_counter_.load(std::memory_order_acquire);
+    if (counter != nullptr)
+      counter->value.fetch_sub(1, std::memory_order_relaxed);
+  }
+
   // atomically sets stack_ back and enqueues all elements to the cache
   bool fetch_new_data(pointer end_ptr) {
     CAF_ASSERT(!end_ptr || end_ptr == stack_empty_dummy());
@@ -317,6 +369,7 @@ private:
     if (head_ != nullptr || fetch_new_data()) {
       auto result = head_;
       head_ = head_->next;
+      dec_size();
       return result;
     }
     return nullptr;
@@ -329,6 +382,7 @@ private:
       f(*head_);
       delete_(head_);
       head_ = next;
+      dec_size();
     }
   }
 
@@ -0,0 +1,148 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_SLIDING_AGGREGATOR_HPP
+#define CAF_DETAIL_SLIDING_AGGREGATOR_HPP
+
+#include <vector>
+#include <utility>
+
+#include "caf/detail/ring_buffer.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Computes an aggregate over a FIFO queue of values in amortized constant
+/// time per operation. Uses subtract-on-evict for aggregates with an inverse
+/// operation and two stacks otherwise.
+template <class Aggregate, bool Invertible = Aggregate::invertible>
+class sliding_aggregator;
+
+/// Removes evicted values from the aggregate via `Aggregate::inverse`.
+template <class Aggregate>
+class sliding_aggregator<Aggregate, true> {
+public:
+  using value_type = typename Aggregate::value_type;
+
+  sliding_aggregator(Aggregate f = Aggregate{})
+      : f_(std::move(f)),
+        acc_(f_.identity()) {
+    // nop
+  }
+
+  size_t size() const {
+    return xs_.size();
+  }
+
+  bool empty() const {
+    return xs_.empty();
+  }
+
+  void push(value_type x) {
+    acc_ = f_.combine(acc_, x);
+    xs_.push_back(std::move(x));
+  }
+
+  /// @pre `!empty()`
+  void pop() {
+    acc_ = f_.inverse(acc_, xs_.front());
+    xs_.pop_front();
+  }
+
+  void clear() {
+    xs_.clear();
+    acc_ = f_.identity();
+  }
+
+  value_type get() const {
+    return acc_;
+  }
+
+private:
+  Aggregate f_;
+  value_type acc_;
+  ring_buffer<value_type> xs_;
+};
+
+/// Keeps values in two stacks: new values go to the back stack and evictions
+/// take from the front stack, which stores partial aggregates from its top to
+/// its bottom. Refilling the front stack reverses the back stack.
+template <class Aggregate>
+class sliding_aggregator<Aggregate, false> {
+public:
+  using value_type = typename Aggregate::value_type;
+
+  sliding_aggregator(Aggregate f = Aggregate{})
+      : f_(std::move(f)),
+        back_acc_(f_.identity()) {
+    // nop
+  }
+
+  size_t size() const {
+    return front_.size() + back_.size();
+  }
+
+  bool empty() const {
+    return front_.empty() && back_.empty();
+  }
+
+  void push(value_type x) {
+    back_acc_ = f_.combine(back_acc_, x);
+    back_.push_back(std::move(x));
+  }
+
+  /// @pre `!empty()`
+  void pop() {
+    if (front_.empty()) {
+      // the oldest value ends up on top of the front stack
+      auto acc = f_.identity();
+      for (auto i = back_.rbegin(); i != back_.rend(); ++i) {
+        acc = f_.combine(*i, acc);
+        front_.emplace_back(acc);
+      }
+      back_.clear();
+      back_acc_ = f_.identity();
+    }
+    front_.pop_back();
+  }
+
+  void clear() {
+    front_.clear();
+    back_.clear();
+    back_acc_ = f_.identity();
+  }
+
+  value_type get() const {
+    if (front_.empty())
+      return back_acc_;
+    return f_.combine(front_.back(), back_acc_);
+  }
+
+private:
+  Aggregate f_;
+  // partial aggregates of all values from the top down to each position
+  std::vector<value_type> front_;
+  std::vector<value_type> back_;
+  value_type back_acc_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_SLIDING_AGGREGATOR_HPP
@@ -20,52 +20,85 @@
 #ifndef CAF_DETAIL_SPLIT_JOIN_HPP
 #define CAF_DETAIL_SPLIT_JOIN_HPP
 
+#include <mutex>
+#include <memory>
 #include <vector>
 
+#include "caf/send.hpp"
 #include "caf/actor.hpp"
-#include "caf/locks.hpp"
+#include "caf/behavior.hpp"
 #include "caf/actor_system.hpp"
+#include "caf/spawn_options.hpp"
 #include "caf/event_based_actor.hpp"
 
-#include "caf/detail/shared_spinlock.hpp"
+#include "caf/detail/behavior_impl.hpp"
 
 namespace caf {
 namespace detail {
 
 using actor_msg_vec = std::vector<std::pair<actor, message>>;
 
+/// Catch-all behavior for receiving responses of split_join workers.
+template <class F>
+class split_join_response_handler : public behavior_impl {
+public:
+  explicit split_join_response_handler(F f) : f_(std::move(f)) {
+    // nop
+  }
+
+  match_case::result invoke(invoke_result_visitor& f,
+                            type_erased_tuple& xs) override {
+    auto msg = message::copy(xs);
+    f_(msg);
+    f();
+    return match_case::match;
+  }
+
+  pointer copy(const generic_timeout_definition&) const override {
+    return make_counted<split_join_response_handler>(f_);
+  }
+
+private:
+  F f_;
+};
+
+/// Runs any number of split/join operations concurrently. Each request
+/// consists of the workers selected by the pool and the original message.
 template <class T, class Split, class Join>
 class split_join_collector : public event_based_actor {
 public:
-  split_join_collector(actor_config& cfg, T init_value,
-                       Split s, Join j, actor_msg_vec xs)
+  split_join_collector(actor_config& cfg, T init_value, Split s, Join j)
       : event_based_actor(cfg),
-        workset_(std::move(xs)),
-        awaited_results_(workset_.size()),
         join_(std::move(j)),
         split_(std::move(s)),
-        value_(std::move(init_value)) {
+        init_(std::move(init_value)) {
     // nop
   }
 
   behavior make_behavior() override {
     auto f = [=](scheduled_actor*, message_view& xs) -> result<message> {
       auto msg = xs.move_content_to_message();
-      auto rp = this->make_response_promise();
-      split_(workset_, msg);
-      for (auto& x : workset_)
-        this->send(x.first, std::move(x.second));
-      auto g = [=](scheduled_actor*, message_view& ys) mutable
-               -> result<message> {
-        auto res = ys.move_content_to_message();
-        join_(value_, res);
-        if (--awaited_results_ == 0) {
-          rp.deliver(value_);
-          quit();
-        }
-        return delegated<message>{};
+      if (!msg.match_elements<actor_msg_vec, message>())
+        return sec::unexpected_message;
+      auto& workset = msg.get_mutable_as<actor_msg_vec>(0);
+      split_(workset, msg.get_mutable_as<message>(1));
+      auto st = std::make_shared<request_state>(init_, workset.size(),
+                                                this->make_response_promise());
+      auto g = [=](message& res) {
+        join_(st->value, res);
+        if (--st->awaited_results == 0)
+          st->rp.deliver(st->value);
       };
-      set_default_handler(g);
+      using handler = split_join_response_handler<decltype(g)>;
+      for (auto& x : workset) {
+        auto mid = this->new_request_id(message_priority::normal);
+        x.first->enqueue(make_mailbox_element(this->ctrl(), mid, {},
+                                              std::move(x.second)),
+                         this->context());
+        behavior::impl_ptr bhvr = make_counted<handler>(g);
+        this->add_multiplexed_response_handler(mid.response_id(),
+                                               std::move(bhvr));
+      }
       return delegated<message>{};
     };
     set_default_handler(f);
@@ -77,11 +110,21 @@ public:
   }
 
 private:
-  actor_msg_vec workset_;
-  size_t awaited_results_;
+  struct request_state {
+    request_state(T x, size_t n, response_promise p)
+        : value(std::move(x)),
+          awaited_results(n),
+          rp(std::move(p)) {
+      // nop
+    }
+    T value;
+    size_t awaited_results;
+    response_promise rp;
+  };
+
   Join join_;
   Split split_;
-  T value_;
+  T init_;
 };
 
 struct nop_split {
@@ -98,35 +141,53 @@ public:
   split_join(T init_value, Split s, Join j)
       : init_(std::move(init_value)),
         sf_(std::move(s)),
-        jf_(std::move(j)) {
+        jf_(std::move(j)),
+        collector_(std::make_shared<collector_state>()) {
     // nop
   }
 
-  void operator()(actor_system& sys,
-                  upgrade_lock<detail::shared_spinlock>& ulock,
-                  const std::vector<actor>& workers,
-                  mailbox_element_ptr& ptr,
-                  execution_unit* host) {
+  void operator()(actor_system& sys, const std::vector<actor>& workers,
+                  mailbox_element_ptr& ptr, execution_unit* host) {
     if (!ptr->sender)
       return;
+    // All requests share a single collector that we spawn lazily, since
+    // spawning an actor per request dominates the cost of small tasks.
+    std::call_once(collector_->flag, [&] {
+      using collector_t = split_join_collector<T, Split, Join>;
+      collector_->hdl = sys.spawn<collector_t, lazy_init + hidden>(init_, sf_,
+                                                                   jf_);
+    });
     actor_msg_vec xs;
     xs.reserve(workers.size());
     for (const auto & worker : workers)
       xs.emplace_back(worker, message{});
-    ulock.unlock();
-    using collector_t = split_join_collector<T, Split, Join>;
-    auto hdl = sys.spawn<collector_t, lazy_init>(init_, sf_, jf_, std::move(xs));
-    hdl->enqueue(std::move(ptr), host);
+    auto content = ptr->move_content_to_message();
+    collector_->hdl->enqueue(
+      make_mailbox_element(std::move(ptr->sender), ptr->mid,
+                           std::move(ptr->stages), std::move(xs),
+                           std::move(content)),
+      host);
   }
 
 private:
+  // Shared by all copies of this policy. Stops the collector after
+  // destroying the last copy, i.e., after destroying the pool.
+  struct collector_state {
+    ~collector_state() {
+      if (hdl)
+        anon_send_exit(hdl, exit_reason::user_shutdown);
+    }
+    std::once_flag flag;
+    actor hdl;
+  };
+
   T init_;
   Split sf_; // split function
   Join jf_;  // join function
+  std::shared_ptr<collector_state> collector_;
 };
 
 } // namespace detail
 } // namespace caf
 
 #endif // CAF_DETAIL_SPLIT_JOIN_HPP
-
@@ -0,0 +1,81 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_THROUGHPUT_CREDIT_CONTROLLER_HPP
+#define CAF_DETAIL_THROUGHPUT_CREDIT_CONTROLLER_HPP
+
+#include "caf/credit_controller.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Sizes credit to keep a fixed amount of work in flight. The controller
+/// keeps moving averages of the processing time per element and of the
+/// latency between granting credit and receiving the corresponding batch.
+/// Credit covers `credit_budget` plus the measured latency of work, i.e.,
+/// the sink never runs dry while waiting for the next batch, and batches
+/// cover `batch_budget` of work.
+class throughput_credit_controller : public credit_controller {
+public:
+  /// @param credit_budget Desired amount of work in flight.
+  /// @param batch_budget Desired amount of work per batch.
+  /// @param initial_credit Credit before the first measurement.
+  /// @param min_credit Lower bound for credit and batch sizes.
+  /// @param max_credit Upper bound for credit and batch sizes.
+  throughput_credit_controller(timespan credit_budget, timespan batch_budget,
+                               long initial_credit, long min_credit,
+                               long max_credit);
+
+  ~throughput_credit_controller() override;
+
+  void batch_processed(long num_elements, timespan processing_time,
+                       timespan latency) override;
+
+  long max_credit() const override;
+
+  long batch_size() const override;
+
+  /// Returns the average processing time per element in nanoseconds or 0
+  /// if no measurement exists yet.
+  double ns_per_element() const {
+    return ns_per_element_;
+  }
+
+  /// Returns the average latency of batches in nanoseconds.
+  double latency_ns() const {
+    return latency_ns_;
+  }
+
+private:
+  long clamp(double x) const;
+
+  double credit_budget_ns_;
+  double batch_budget_ns_;
+  long min_credit_;
+  long max_credit_;
+  double ns_per_element_;
+  double latency_ns_;
+  long credit_;
+  long batch_size_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_THROUGHPUT_CREDIT_CONTROLLER_HPP
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TOPIC_TRIE_HPP
+#define CAF_DETAIL_TOPIC_TRIE_HPP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Indexes subscribers by hierarchical topic patterns. Topics consist of
+/// levels separated by `/`, e.g., `sensors/eu/de/temp`. In a pattern, the
+/// level `*` matches exactly one level and a trailing `**` matches any number
+/// of levels (including none), e.g., `sensors/eu/*/temp` or `sensors/**`.
+/// @note This data structure is not thread-safe.
+class topic_trie {
+public:
+  using subscriber_vec = std::vector<strong_actor_ptr>;
+
+  /// Returns whether `x` is a valid pattern, i.e., is not empty, has no
+  /// empty levels and uses `**` only as its last level.
+  static bool valid_pattern(const std::string& x);
+
+  /// Returns whether `x` contains a wildcard level.
+  static bool is_pattern(const std::string& x);
+
+  /// Returns whether `pattern` matches `topic`.
+  static bool matches(const std::string& pattern, const std::string& topic);
+
+  /// Adds `who` as subscriber for `pattern`. Returns `false` if `who` already
+  /// subscribed to `pattern`, `true` otherwise.
+  bool add(const std::string& pattern, strong_actor_ptr who);
+
+  /// Removes `who` from the subscribers for `pattern`. Returns `false` if
+  /// `who` was not subscribed to `pattern`, `true` otherwise.
+  bool erase(const std::string& pattern, const actor_control_block* who);
+
+  /// Returns all subscribers to a pattern matching `topic` without
+  /// duplicates.
+  subscriber_vec match(const std::string& topic) const;
+
+  /// Returns the number of distinct (pattern, subscriber) pairs.
+  size_t size() const {
+    return size_;
+  }
+
+  /// Removes all subscribers.
+  void clear();
+
+private:
+  struct node {
+    std::map<std::string, std::unique_ptr<node>> children;
+    subscriber_vec subscribers;
+  };
+
+  using level_vec = std::vector<std::string>;
+
+  static level_vec split(const std::string& x);
+
+  static void collect(const node& x, const level_vec& levels, size_t pos,
+                      subscriber_vec& result);
+
+  node root_;
+  size_t size_ = 0;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TOPIC_TRIE_HPP
@@ -20,11 +20,12 @@
 #ifndef CAF_DOWNSTREAM_HPP
 #define CAF_DOWNSTREAM_HPP
 
-#include <deque>
 #include <vector>
 
 #include "caf/make_message.hpp"
 
+#include "caf/detail/ring_buffer.hpp"
+
 namespace caf {
 
 /// Grants access to an output stream buffer.
@@ -34,7 +35,11 @@ public:
   // -- member types -----------------------------------------------------------
 
   /// A queue of items for temporary storage before moving them into chunks.
-  using queue_type = std::deque<T>;
+  /// @note This used to be a `std::deque<T>`. The ring buffer provides the
+  ///       same interface for appending, removing and accessing elements,
+  ///       but it neither has `shrink_to_fit` nor stable references when
+  ///       appending elements.
+  using queue_type = detail::ring_buffer<T>;
 
   // -- constructors, destructors, and assignment operators --------------------
 
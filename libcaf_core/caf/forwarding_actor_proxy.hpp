@@ -44,6 +44,9 @@ public:
 
   void kill_proxy(execution_unit* ctx, error rsn) override;
 
+  /// Returns the actor this proxy forwards all messages to.
+  actor manager() const;
+
 private:
   void forward_msg(strong_actor_ptr sender, message_id mid, message msg,
                    const forwarding_stack* fwd = nullptr);
@@ -177,6 +177,12 @@ public:
       ptr->emit_batches();
   }
 
+  void force_emit_batches() override {
+    CAF_LOG_TRACE("");
+    for (auto ptr : ptrs_)
+      ptr->force_emit_batches();
+  }
+
   path_ptr find(const stream_id& sid, const actor_addr& x) override{
     return first_hit([&](const_pointer ptr) { return ptr->find(sid, x); });
   }
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_FUSED_STAGE_HPP
+#define CAF_FUSED_STAGE_HPP
+
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "caf/downstream.hpp"
+#include "caf/stream_stage_trait.hpp"
+
+#include "caf/detail/type_list.hpp"
+
+namespace caf {
+
+/// Composes several stage functions with the signature
+/// `void (State&, downstream<Out>&, In)` into a single stage function. Each
+/// element runs through all steps before the stage processes the next element
+/// of a batch. Steps hand elements to their successor via small queues that
+/// hold only the output for a single element and retain their memory between
+/// elements. The state of a fused stage is a tuple of all step states.
+template <class... Fs>
+class fused_stage {
+public:
+  static_assert(sizeof...(Fs) > 0, "cannot fuse an empty list of steps");
+
+  using steps = detail::type_list<Fs...>;
+
+  using state = std::tuple<typename stream_stage_trait_t<Fs>::state...>;
+
+  using input = typename stream_stage_trait_t<
+    typename detail::tl_head<steps>::type
+  >::input;
+
+  using output = typename stream_stage_trait_t<
+    typename detail::tl_back<steps>::type
+  >::output;
+
+  explicit fused_stage(Fs... fs) : fs_(std::move(fs)...) {
+    // nop
+  }
+
+  void operator()(state& st, downstream<output>& out, input x) {
+    std::integral_constant<size_t, 0> first;
+    feed(first, steps{}, st, out, std::move(x));
+  }
+
+private:
+  // the last step writes directly to the output of the stage
+  template <size_t I, class F, class T>
+  void feed(std::integral_constant<size_t, I>, detail::type_list<F>,
+            state& st, downstream<output>& out, T&& x) {
+    std::get<I>(fs_)(std::get<I>(st), out, std::forward<T>(x));
+  }
+
+  template <size_t I, class F, class G, class... Gs, class T>
+  void feed(std::integral_constant<size_t, I>, detail::type_list<F, G, Gs...>,
+            state& st, downstream<output>& out, T&& x) {
+    using step_output = typename stream_stage_trait_t<F>::output;
+    static_assert(std::is_same<
+                    step_output,
+                    typename std::decay<
+                      typename stream_stage_trait_t<G>::input
+                    >::type
+                  >::value,
+                  "output of a step must match the input of the next step");
+    auto& buf = std::get<I>(bufs_);
+    downstream<step_output> ds{buf};
+    std::get<I>(fs_)(std::get<I>(st), ds, std::forward<T>(x));
+    std::integral_constant<size_t, I + 1> next;
+    for (auto& y : buf)
+      feed(next, detail::type_list<G, Gs...>{}, st, out, std::move(y));
+    buf.clear();
+  }
+
+  template <class F>
+  using queue_type =
+    typename downstream<typename stream_stage_trait_t<F>::output>::queue_type;
+
+  std::tuple<Fs...> fs_;
+  // the queue of the last step remains unused
+  std::tuple<queue_type<Fs>...> bufs_;
+};
+
+/// Fuses `fs` into a single stage function for `make_stage`.
+/// @relates fused_stage
+template <class... Fs>
+fused_stage<Fs...> fuse(Fs... fs) {
+  return fused_stage<Fs...>{std::move(fs)...};
+}
+
+} // namespace caf
+
+#endif // CAF_FUSED_STAGE_HPP
@@ -101,6 +101,7 @@ class message_handler;
 class scheduled_actor;
 class stream_scatterer;
 class response_promise;
+class credit_controller;
 class event_based_actor;
 class type_erased_tuple;
 class type_erased_value;
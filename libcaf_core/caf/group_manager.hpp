@@ -58,6 +58,12 @@ public:
 
   /// Get a handle to the group associated with
   /// `identifier` from the module `mod_name`.
+  ///
+  /// The built-in module `topic` interprets identifiers as hierarchical
+  /// topics with levels separated by `/`. Joining `sensors/eu/*/temp` or
+  /// `sensors/**` subscribes to all matching topics, where `*` matches
+  /// exactly one level and a trailing `**` any number of levels. Sending to
+  /// a topic without wildcards delivers to all matching subscribers.
   /// @threadsafe
   expected<group> get(const std::string& module_name,
                       const std::string& group_identifier) const;
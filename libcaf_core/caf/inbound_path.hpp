@@ -20,6 +20,10 @@
 #ifndef CAF_INBOUND_PATH_HPP
 #define CAF_INBOUND_PATH_HPP
 
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <utility>
 #include <cstddef>
 #include <cstdint>
 
@@ -27,6 +31,7 @@
 #include "caf/stream_msg.hpp"
 #include "caf/stream_aborter.hpp"
 #include "caf/stream_priority.hpp"
+#include "caf/credit_controller.hpp"
 #include "caf/actor_control_block.hpp"
 
 #include "caf/meta/type_name.hpp"
@@ -74,6 +79,23 @@ public:
   /// whether the destructor sends `close` or `forced_close` messages.
   error shutdown_reason;
 
+  /// Computes credit for this path.
+  std::unique_ptr<credit_controller> controller;
+
+  /// Time type for measuring the latency of batches.
+  using time_point = std::chrono::steady_clock::time_point;
+
+  /// Stores credit grants that are not yet covered by received batches in
+  /// the form of (total credit after the grant, time of the grant). Only
+  /// used if `controller` measures latency.
+  std::deque<std::pair<long, time_point>> credit_grants;
+
+  /// Sum of all credit granted on this path.
+  long total_credit;
+
+  /// Sum of all elements received on this path.
+  long total_received;
+
   /// Constructs a path for given handle and stream ID.
   inbound_path(local_actor* selfptr, const stream_id& id, strong_actor_ptr ptr);
 
@@ -89,6 +111,14 @@ public:
 
   void emit_ack_batch(long new_demand);
 
+  /// Stores that this path granted `amount` credit at `t`.
+  void record_grant(long amount, time_point t);
+
+  /// Returns the time between granting the credit for the last element of a
+  /// batch of `n` elements and receiving it at `t`. Drops all grants fully
+  /// covered by received batches.
+  timespan batch_latency(long n, time_point t);
+
   static void emit_irregular_shutdown(local_actor* self, const stream_id& sid,
                                       const strong_actor_ptr& hdl,
                                       error reason);
@@ -60,6 +60,8 @@ public:
 
   void emit_batches() override;
 
+  void force_emit_batches() override;
+
   path_type* find(const stream_id& sid, const actor_addr& x) override;
 
   long credit() const override;
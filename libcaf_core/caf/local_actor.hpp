@@ -105,6 +105,10 @@ public:
 
   void on_destroy() override;
 
+  size_t mailbox_size_hint() const noexcept override;
+
+  void track_mailbox_size() override;
+
   // -- pure virtual modifiers -------------------------------------------------
 
   virtual void launch(execution_unit* eu, bool lazy, bool hide) = 0;
@@ -0,0 +1,226 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_ORDERED_MERGE_GATHERER_HPP
+#define CAF_ORDERED_MERGE_GATHERER_HPP
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "caf/message.hpp"
+#include "caf/make_message.hpp"
+#include "caf/stream_gatherer_impl.hpp"
+
+#include "caf/detail/ring_buffer.hpp"
+
+namespace caf {
+
+/// Merges sorted input from any number of sources into a single sorted
+/// sequence (k-way merge). An element becomes ready for processing only after
+/// each open path has at least one buffered element, i.e., after the gatherer
+/// knows the minimum key over all paths. Hence, paths with an empty buffer
+/// block the merge and receive credit first. All other paths receive credit
+/// in ascending order of the key at the front of their buffer.
+///
+/// Each path buffers at most `max_credit()` elements (including assigned but
+/// not yet received credit), which bounds memory usage to `k * max_credit()`
+/// elements for `k` paths. Note that a path added later only takes part in
+/// the merge of elements that the gatherer did not yet release.
+/// @tparam T Element type.
+/// @tparam KeyFn Default-constructible function object with signature
+///               `K (const T&)` for any `K` that is less-than comparable.
+/// @pre Each source emits its elements in ascending key order.
+template <class T, class KeyFn>
+class ordered_merge_gatherer : public stream_gatherer_impl {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = stream_gatherer_impl;
+
+  using value_type = T;
+
+  using buffer_type = detail::ring_buffer<value_type>;
+
+  using batch_type = std::vector<value_type>;
+
+  /// Buffered elements of a single path. The gatherer keeps lanes of removed
+  /// paths with `path == nullptr` until consuming their remaining elements.
+  struct lane {
+    path_ptr path;
+    buffer_type buf;
+  };
+
+  using lane_vec = std::vector<lane>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ordered_merge_gatherer(local_actor* selfptr) : super(selfptr) {
+    // nop
+  }
+
+  // -- overridden functions ---------------------------------------------------
+
+  path_ptr add_path(const stream_id& sid, strong_actor_ptr x,
+                    strong_actor_ptr original_stage, stream_priority prio,
+                    long available_credit, bool redeployable,
+                    response_promise result_cb) override {
+    auto ptr = super::add_path(sid, std::move(x), std::move(original_stage),
+                               prio, available_credit, redeployable,
+                               std::move(result_cb));
+    if (ptr != nullptr)
+      lanes_.push_back(lane{ptr, buffer_type{}});
+    return ptr;
+  }
+
+  bool remove_path(const stream_id& sid, const actor_addr& x, error reason,
+                   bool silent) override {
+    auto ptr = find(sid, x);
+    if (ptr == nullptr)
+      return false;
+    // Buffered elements of the path still take part in the merge.
+    auto i = find_lane(ptr);
+    if (i != lanes_.end()) {
+      if (i->buf.empty())
+        lanes_.erase(i);
+      else
+        i->path = nullptr;
+    }
+    return super::remove_path(sid, x, std::move(reason), silent);
+  }
+
+  void close(message result) override {
+    lanes_.clear();
+    super::close(std::move(result));
+  }
+
+  void abort(error reason) override {
+    lanes_.clear();
+    super::abort(std::move(reason));
+  }
+
+  long initial_credit(long available, path_type* x) override {
+    return std::min(available, x->controller->max_credit());
+  }
+
+  void assign_credit(long available) override {
+    CAF_LOG_TRACE(CAF_ARG(available));
+    // Paths blocking the merge go first, followed by paths in ascending order
+    // of their minimum key, since we consume these elements first.
+    auto rank = [&](const assignment_pair& x, const assignment_pair& y) {
+      auto& xs = find_lane(x.first)->buf;
+      auto& ys = find_lane(y.first)->buf;
+      if (xs.empty() || ys.empty())
+        return xs.empty() && !ys.empty();
+      return key_fn_(xs.front()) < key_fn_(ys.front());
+    };
+    std::stable_sort(assignment_vec_.begin(), assignment_vec_.end(), rank);
+    for (auto& kvp : assignment_vec_) {
+      auto& path = *kvp.first;
+      auto& ctrl = *path.controller;
+      auto buffered = static_cast<long>(find_lane(kvp.first)->buf.size());
+      auto x = std::min(available,
+                        ctrl.max_credit() - path.assigned_credit - buffered);
+      // Hand out credit in chunks of at least one batch unless the source ran
+      // out of credit, since it otherwise sends many small batches.
+      if (x <= 0 || (x < ctrl.batch_size() && path.assigned_credit > 0))
+        x = 0;
+      available -= x;
+      kvp.second = x;
+    }
+    emit_credits();
+  }
+
+  message merge(path_ptr from, message& xs) override {
+    CAF_LOG_TRACE(CAF_ARG(xs));
+    if (!xs.match_elements<batch_type>())
+      return std::move(xs);
+    auto i = find_lane(from);
+    if (i == lanes_.end()) {
+      CAF_LOG_WARNING("received batch for unknown lane");
+      return message{};
+    }
+    auto& ys = xs.get_mutable_as<batch_type>(0);
+    i->buf.reserve(i->buf.size() + ys.size());
+    for (auto& y : ys)
+      i->buf.push_back(std::move(y));
+    return drain();
+  }
+
+  message drain() override {
+    batch_type result;
+    for (;;) {
+      auto min_lane = lanes_.end();
+      for (auto i = lanes_.begin(); i != lanes_.end(); ++i) {
+        if (i->buf.empty()) {
+          // An open path without data blocks the merge.
+          if (i->path != nullptr)
+            return make_result(result);
+        } else if (min_lane == lanes_.end()
+                   || key_fn_(i->buf.front()) < key_fn_(min_lane->buf.front())) {
+          min_lane = i;
+        }
+      }
+      if (min_lane == lanes_.end())
+        return make_result(result);
+      result.push_back(std::move(min_lane->buf.front()));
+      min_lane->buf.pop_front();
+      if (min_lane->buf.empty() && min_lane->path == nullptr)
+        lanes_.erase(min_lane);
+    }
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of elements waiting for the merge.
+  long buffered() const {
+    long result = 0;
+    for (auto& x : lanes_)
+      result += static_cast<long>(x.buf.size());
+    return result;
+  }
+
+  const lane_vec& lanes() const {
+    return lanes_;
+  }
+
+  KeyFn& key_function() {
+    return key_fn_;
+  }
+
+private:
+  typename lane_vec::iterator find_lane(path_ptr ptr) {
+    auto pred = [&](const lane& x) {
+      return x.path == ptr;
+    };
+    return std::find_if(lanes_.begin(), lanes_.end(), pred);
+  }
+
+  static message make_result(batch_type& xs) {
+    return xs.empty() ? message{} : make_message(std::move(xs));
+  }
+
+  lane_vec lanes_;
+  KeyFn key_fn_;
+};
+
+} // namespace caf
+
+#endif // CAF_ORDERED_MERGE_GATHERER_HPP
@@ -0,0 +1,261 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_PARTITIONED_SCATTERER_HPP
+#define CAF_PARTITIONED_SCATTERER_HPP
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "caf/node_id.hpp"
+#include "caf/buffered_scatterer.hpp"
+
+#include "caf/detail/pool_policies.hpp"
+
+namespace caf {
+
+/// A scatterer that partitions data by key, i.e., sends each element to
+/// exactly one sink and all elements with the same key to the same sink.
+/// Each sink has its own buffer and receives batches according to its own
+/// credit, i.e., a slow sink only holds back the elements assigned to it.
+///
+/// Sinks are selected via a consistent hash ring with `virtual_nodes` points
+/// per sink. The scatterer rebuilds the ring whenever a sink joins or leaves,
+/// which keeps selecting a sink at `O(log n)` per element for `n` sinks.
+/// Adding a sink only moves keys to the new sink and removing a sink only
+/// moves the keys it owned. Elements buffered for a removed sink get assigned
+/// to the remaining sinks.
+/// @tparam KeyFn Default-constructible function object with signature
+///               `K (const T&)` for any `K` with a specialization of
+///               `std::hash`.
+template <class T, class KeyFn>
+class partitioned_scatterer : public buffered_scatterer<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using super = buffered_scatterer<T>;
+
+  using path_ptr = typename super::path_ptr;
+
+  using buffer_type = typename super::buffer_type;
+
+  using key_type = typename std::decay<
+    decltype(std::declval<KeyFn&>()(std::declval<const T&>()))>::type;
+
+  /// Buffered elements of a single sink.
+  struct partition {
+    path_ptr path;
+    uint64_t seed;
+    buffer_type buf;
+  };
+
+  using partition_vec = std::vector<partition>;
+
+  /// Sorted list of (hash, partition index) pairs.
+  using ring_type = std::vector<std::pair<uint64_t, size_t>>;
+
+  /// Number of points on the hash ring per sink.
+  static constexpr size_t virtual_nodes = 32;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  partitioned_scatterer(local_actor* selfptr) : super(selfptr) {
+    // nop
+  }
+
+  // -- overridden functions ---------------------------------------------------
+
+  path_ptr add_path(const stream_id& sid, strong_actor_ptr origin,
+                    strong_actor_ptr sink_ptr,
+                    mailbox_element::forwarding_stack stages,
+                    message_id handshake_mid, message handshake_data,
+                    stream_priority prio, bool redeployable) override {
+    auto seed = make_seed(sink_ptr);
+    auto ptr = super::add_path(sid, std::move(origin), std::move(sink_ptr),
+                               std::move(stages), handshake_mid,
+                               std::move(handshake_data), prio, redeployable);
+    if (ptr != nullptr) {
+      partitions_.push_back(partition{ptr, seed, buffer_type{}});
+      update_ring();
+    }
+    return ptr;
+  }
+
+  using super::remove_path;
+
+  bool remove_path(const stream_id& sid, const actor_addr& x,
+                   error reason, bool silent) override {
+    CAF_LOG_TRACE(CAF_ARG(sid) << CAF_ARG(x)
+                  << CAF_ARG(reason) << CAF_ARG(silent));
+    auto i = this->iter_find(this->paths_, sid, x);
+    if (i == this->paths_.end())
+      return false;
+    erase_partition(i->get());
+    return super::remove_path(i, std::move(reason), silent);
+  }
+
+  void close() override {
+    partitions_.clear();
+    ring_.clear();
+    super::close();
+  }
+
+  void abort(error reason) override {
+    partitions_.clear();
+    ring_.clear();
+    super::abort(std::move(reason));
+  }
+
+  /// Returns `buffered()` plus the minimum of `open_credit - buf.size()` over
+  /// all partitions, minus elements not assigned to a partition yet. Since
+  /// each element may end up in any partition, this bounds the buffer of each
+  /// partition by the credit of its sink even for skewed keys.
+  long credit() const override {
+    if (partitions_.empty())
+      return buffered();
+    auto headroom = std::numeric_limits<long>::max();
+    for (auto& x : partitions_)
+      headroom = std::min(headroom, x.path->open_credit
+                                    - static_cast<long>(x.buf.size()));
+    headroom -= super::buffered();
+    return buffered() + std::max(headroom, 0l);
+  }
+
+  long buffered() const override {
+    auto result = super::buffered();
+    for (auto& x : partitions_)
+      result += static_cast<long>(x.buf.size());
+    return result;
+  }
+
+  void emit_batches() override {
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    emit_batches_impl(true);
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  const partition_vec& partitions() const {
+    return partitions_;
+  }
+
+  KeyFn& key_function() {
+    return key_fn_;
+  }
+
+  /// Returns the partition for `x` or `nullptr` if no sink exists.
+  partition* select(const T& x) {
+    if (ring_.empty())
+      return nullptr;
+    std::hash<key_type> h;
+    auto key = detail::mix64(static_cast<uint64_t>(h(key_fn_(x))));
+    using value_type = typename ring_type::value_type;
+    auto i = std::lower_bound(ring_.begin(), ring_.end(), key,
+                              [](const value_type& y, uint64_t z) {
+                                return y.first < z;
+                              });
+    return &partitions_[i != ring_.end() ? i->second : ring_.front().second];
+  }
+
+protected:
+  static uint64_t make_seed(const strong_actor_ptr& x) {
+    if (!x)
+      return 0;
+    return detail::mix64(static_cast<uint64_t>(x->id()))
+           ^ static_cast<uint64_t>(std::hash<node_id>{}(x->node()));
+  }
+
+  /// Places `virtual_nodes` points per partition on the ring. The position of
+  /// each point only depends on the seed of its partition.
+  void update_ring() {
+    ring_.clear();
+    ring_.reserve(partitions_.size() * virtual_nodes);
+    for (size_t i = 0; i < partitions_.size(); ++i)
+      for (size_t j = 0; j < virtual_nodes; ++j)
+        ring_.emplace_back(detail::mix64(partitions_[i].seed
+                                         + j * 0x9E3779B97F4A7C15ull),
+                           i);
+    std::sort(ring_.begin(), ring_.end());
+  }
+
+  /// Moves the buffered elements of `ptr` back into the central buffer and
+  /// removes its partition.
+  void erase_partition(path_ptr ptr) {
+    auto pred = [&](const partition& x) {
+      return x.path == ptr;
+    };
+    auto e = partitions_.end();
+    auto i = std::find_if(partitions_.begin(), e, pred);
+    if (i == e)
+      return;
+    if (!i->buf.empty()) {
+      // Elements of the removed partition precede anything in `buf_`.
+      auto& buf = this->buf_;
+      i->buf.reserve(i->buf.size() + buf.size());
+      buf.move_front(buf.size(), std::back_inserter(i->buf));
+      buf.swap(i->buf);
+    }
+    partitions_.erase(i);
+    update_ring();
+  }
+
+  /// Spreads the content of `buf_` to `partitions_`.
+  void fan_out() {
+    if (partitions_.empty())
+      return;
+    auto& buf = this->buf_;
+    while (!buf.empty()) {
+      select(buf.front())->buf.push_back(std::move(buf.front()));
+      buf.pop_front();
+    }
+  }
+
+  void emit_batches_impl(bool force) {
+    CAF_LOG_TRACE(CAF_ARG(force));
+    fan_out();
+    auto threshold = this->batch_threshold(force);
+    auto limit = this->batch_limit();
+    for (auto& p : partitions_) {
+      for (;;) {
+        auto n = std::min({p.path->open_credit,
+                           static_cast<long>(p.buf.size()), limit});
+        if (n <= 0 || n < threshold)
+          break;
+        p.path->emit_batch(n, this->make_batch(p.buf, n));
+      }
+    }
+  }
+
+  partition_vec partitions_;
+  ring_type ring_;
+  KeyFn key_fn_;
+};
+
+} // namespace caf
+
+#endif // CAF_PARTITIONED_SCATTERER_HPP
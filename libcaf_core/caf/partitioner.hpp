@@ -0,0 +1,108 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_PARTITIONER_HPP
+#define CAF_PARTITIONER_HPP
+
+#include <utility>
+
+#include "caf/atom.hpp"
+#include "caf/unit.hpp"
+#include "caf/stream.hpp"
+#include "caf/behavior.hpp"
+#include "caf/downstream.hpp"
+#include "caf/stateful_actor.hpp"
+#include "caf/random_gatherer.hpp"
+#include "caf/stream_stage_impl.hpp"
+#include "caf/event_based_actor.hpp"
+#include "caf/partitioned_scatterer.hpp"
+
+namespace caf {
+
+/// State of a stage that forwards its input to any number of sinks,
+/// partitioned by key.
+/// @relates partitioner
+template <class T, class KeyFn>
+struct partitioner_state {
+  struct process {
+    void operator()(unit_t&, downstream<T>& out, T x) {
+      out.push(std::move(x));
+    }
+  };
+
+  struct cleanup {
+    void operator()(unit_t&) {
+      // nop
+    }
+  };
+
+  using scatterer_type = partitioned_scatterer<T, KeyFn>;
+
+  using stage_impl = stream_stage_impl<process, cleanup, random_gatherer,
+                                       scatterer_type>;
+
+  intrusive_ptr<stage_impl> stage;
+
+  static const char* name;
+};
+
+template <class T, class KeyFn>
+const char* partitioner_state<T, KeyFn>::name = "partitioner";
+
+/// Implements a stage that sends each element of its input to exactly one
+/// sink, selected by the key of the element. Sinks join the stage by sending
+/// `join_atom` and sources by sending a `stream<T>`. The stage keeps its
+/// sinks until the first source joins and closes them when all sources are
+/// done.
+template <class T, class KeyFn>
+behavior partitioner(stateful_actor<partitioner_state<T, KeyFn>>* self) {
+  stream_id id{self->ctrl(),
+               self->new_request_id(message_priority::normal).integer_value()};
+  using impl = typename partitioner_state<T, KeyFn>::stage_impl;
+  using process = typename partitioner_state<T, KeyFn>::process;
+  using cleanup = typename partitioner_state<T, KeyFn>::cleanup;
+  self->state.stage = make_counted<impl>(self, id, process{}, cleanup{});
+  // Closing the input before any source arrives drops all sinks.
+  self->state.stage->in().continuous(true);
+  self->streams().emplace(id, self->state.stage);
+  return {
+    [=](join_atom) -> stream<T> {
+      auto sid = self->streams().begin()->first;
+      auto hdl = self->current_sender();
+      if (!self->template add_sink<T>(self->state.stage, sid, nullptr, hdl,
+                                      no_stages, message_id::make(),
+                                      stream_priority::normal,
+                                      std::make_tuple()))
+        return none;
+      self->drop_current_message_id();
+      return sid;
+    },
+    [=](const stream<T>& in) {
+      auto& mgr = self->state.stage;
+      if (self->add_source(mgr, in.id(), none)) {
+        self->streams().emplace(in.id(), mgr);
+        mgr->in().continuous(false);
+      }
+    }
+  };
+}
+
+} // namespace caf
+
+#endif // CAF_PARTITIONER_HPP
@@ -24,6 +24,7 @@
 #include <tuple>
 #include <deque>
 #include <vector>
+#include <algorithm>
 #include <functional>
 
 #include "caf/topic_scatterer.hpp"
@@ -48,17 +49,30 @@ public:
   }
 
   void emit_batches() override {
-    CAF_LOG_TRACE("");
+    emit_batches_impl(false);
+  }
+
+  void force_emit_batches() override {
+    emit_batches_impl(true);
+  }
+
+protected:
+  void emit_batches_impl(bool force) {
+    CAF_LOG_TRACE(CAF_ARG(force));
     this->fan_out();
+    auto threshold = this->batch_threshold(force);
+    auto limit = this->batch_limit();
     for (auto& kvp : this->lanes_) {
       auto& l = kvp.second;
       super::sort_by_credit(l.paths);
       for (auto& x : l.paths) {
-        auto chunk = super::get_chunk(l.buf, x->open_credit);
-        auto csize = static_cast<long>(chunk.size());
-        if (csize == 0)
-          break;
-        x->emit_batch(csize, make_message(std::move(chunk)));
+        for (;;) {
+          auto n = std::min({x->open_credit, static_cast<long>(l.buf.size()),
+                             limit});
+          if (n <= 0 || n < threshold)
+            break;
+          x->emit_batch(n, this->make_batch(l.buf, n));
+        }
       }
     }
   }
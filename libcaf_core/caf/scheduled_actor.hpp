@@ -36,6 +36,7 @@
 #include "caf/local_actor.hpp"
 #include "caf/actor_marker.hpp"
 #include "caf/stream_result.hpp"
+#include "caf/stream_manager.hpp"
 #include "caf/response_handle.hpp"
 #include "caf/scheduled_actor.hpp"
 #include "caf/random_gatherer.hpp"
@@ -128,7 +129,9 @@ public:
     /// Triggers the current behavior.
     ordinary,
     /// Triggers handlers for system messages such as `exit_msg` or `down_msg`.
-    internal
+    internal,
+    /// Flushes partially filled batches of stream managers.
+    stream_tick
   };
 
   /// Result of one-shot activations.
@@ -611,6 +614,17 @@ public:
   /// Returns whether `timeout_id` is currently active.
   bool is_active_timeout(uint32_t tid) const;
 
+  /// Schedules a stream tick for the earliest flush deadline of all stream
+  /// managers unless an earlier tick is already pending.
+  void request_stream_flush();
+
+  /// Forces all stream managers with an expired flush deadline to emit
+  /// their buffered elements and schedules the next stream tick.
+  void handle_stream_flush();
+
+  /// Returns whether `x` is a stream tick scheduled by this actor.
+  bool is_stream_tick(const mailbox_element& x);
+
   // -- message processing -----------------------------------------------------
 
   /// Adds a callback for an awaited response.
@@ -847,6 +861,9 @@ protected:
   /// Identifies the timeout messages we are currently waiting for.
   uint32_t timeout_id_;
 
+  /// Stores the point in time of the next pending stream tick.
+  stream_manager::clock_type::time_point stream_flush_deadline_;
+
   /// Stores callbacks for awaited responses.
   std::forward_list<pending_response> awaited_responses_;
 
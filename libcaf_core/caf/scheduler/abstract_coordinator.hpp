@@ -48,6 +48,9 @@ public:
     max_id
   };
 
+  /// Clock type for timestamps and deadlines of actors.
+  using clock_type = std::chrono::steady_clock;
+
   explicit abstract_coordinator(actor_system& sys);
 
   /// Returns a handle to the central printing actor.
@@ -93,6 +96,9 @@ public:
   /// Returns `true` if this scheduler detaches its utility actors.
   virtual bool detaches_utility_actors() const;
 
+  /// Returns the current time for computing deadlines of delayed messages.
+  virtual clock_type::time_point now() const;
+
   void start() override;
 
   void init(actor_system_config& cfg) override;
@@ -52,11 +52,8 @@ public:
     message msg;
   };
 
-  /// A clock type using the highest available precision.
-  using hrc = std::chrono::high_resolution_clock;
-
   /// A map type for storing scheduled messages and timeouts.
-  std::multimap<hrc::time_point, delayed_msg> delayed_messages;
+  std::multimap<clock_type::time_point, delayed_msg> delayed_messages;
 
   /// Returns whether at least one job is in the queue.
   inline bool has_job() const {
@@ -117,7 +114,8 @@ public:
   /// left. Returns the number of processed events.
   size_t run(size_t max_count = std::numeric_limits<size_t>::max());
 
-  /// Tries to dispatch a single delayed message.
+  /// Tries to dispatch a single delayed message. Advances the time to the
+  /// deadline of the message if necessary.
   bool dispatch_once();
 
   /// Dispatches all pending delayed messages. Returns the number of dispatched
@@ -128,6 +126,18 @@ public:
   /// events (first) and dispatched delayed messages (second).
   std::pair<size_t, size_t> run_dispatch_loop();
 
+  /// Advances the time to the next deadline and dispatches all delayed
+  /// messages due at that time. Returns `false` if no message was pending.
+  bool trigger_timeout();
+
+  /// Triggers all pending timeouts in order of their deadlines. Returns the
+  /// number of dispatched messages.
+  size_t trigger_timeouts();
+
+  /// Returns the simulated time, which only advances when dispatching delayed
+  /// messages.
+  clock_type::time_point now() const override;
+
   template <class F>
   void after_next_enqueue(F f) {
     after_next_enqueue_ = f;
@@ -153,6 +163,9 @@ protected:
 private:
   void inline_all_enqueues_helper();
 
+  /// Current value of the simulated clock.
+  clock_type::time_point current_time_;
+
   /// User-provided callback for triggering custom code in `enqueue`.
   std::function<void()> after_next_enqueue_;
 };
@@ -23,6 +23,7 @@
 #include <limits>
 #include <string>
 #include <sstream>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -198,6 +199,61 @@ protected:
     return none;
   }
 
+  error apply_builtin_array(builtin type, size_t num, void* vals) override {
+    CAF_ASSERT(vals != nullptr);
+    switch (type) {
+      default: // i8_v or u8_v
+        CAF_ASSERT(type == i8_v || type == u8_v);
+        return apply_raw(num, vals);
+      case i16_v:
+      case u16_v:
+        return apply_int_array<uint16_t>(reinterpret_cast<uint16_t*>(vals),
+                                         num);
+      case i32_v:
+      case u32_v:
+        return apply_int_array<uint32_t>(reinterpret_cast<uint32_t*>(vals),
+                                         num);
+      case i64_v:
+      case u64_v:
+        return apply_int_array<uint64_t>(reinterpret_cast<uint64_t*>(vals),
+                                         num);
+      case float_v:
+        return apply_int_array<uint32_t>(reinterpret_cast<float*>(vals), num);
+      case double_v:
+        return apply_int_array<uint64_t>(reinterpret_cast<double*>(vals), num);
+    }
+  }
+
+  // Decodes `num` integers or floating points in network byte order. Uses a
+  // scratch buffer to read many values with a single call to `apply_raw`.
+  template <class Packed, class T>
+  error apply_int_array(T* xs, size_t num) {
+    Packed buf[128];
+    while (num > 0) {
+      auto n = std::min(num, sizeof(buf) / sizeof(Packed));
+      auto e = apply_raw(n * sizeof(Packed), buf);
+      if (e)
+        return e;
+      for (size_t i = 0; i < n; ++i)
+        unpack(detail::from_network_order(buf[i]), xs[i]);
+      xs += n;
+      num -= n;
+    }
+    return none;
+  }
+
+  template <class T>
+  static typename std::enable_if<std::is_integral<T>::value>::type
+  unpack(T x, T& y) {
+    y = x;
+  }
+
+  template <class T, class F>
+  static typename std::enable_if<std::is_floating_point<F>::value>::type
+  unpack(T x, F& y) {
+    y = detail::unpack754(x);
+  }
+
   template <class T>
   error apply_float(T& x) {
     typename detail::ieee_754_trait<T>::packed_type tmp = 0;
@@ -121,6 +121,19 @@ public:
   /// Calculates initial credit for `x` after adding it to the gatherer.
   virtual long initial_credit(long downstream_capacity, path_ptr x) = 0;
 
+  // -- virtual member functions -----------------------------------------------
+
+  /// Hands a batch received from `from` to the gatherer and returns the data
+  /// that is ready for processing. Gatherers that combine inputs may hold
+  /// back elements and return an empty message. The default implementation
+  /// returns `xs` unmodified.
+  virtual message merge(path_ptr from, message& xs);
+
+  /// Returns data the gatherer can release after removing a path, e.g., since
+  /// elements no longer need to wait for input on that path. The default
+  /// implementation returns an empty message.
+  virtual message drain();
+
   // -- convenience functions --------------------------------------------------
 
   /// Removes a path from the gatherer.
@@ -20,6 +20,7 @@
 #ifndef CAF_STREAM_GATHERER_IMPL_HPP
 #define CAF_STREAM_GATHERER_IMPL_HPP
 
+#include <memory>
 #include <vector>
 #include <cstdint>
 #include <utility>
@@ -69,6 +70,10 @@ public:
 protected:
   void emit_credits();
 
+  /// Creates the credit controller for a new path according to the
+  /// `stream-credit-policy` of the actor system.
+  virtual std::unique_ptr<credit_controller> make_credit_controller();
+
   long high_watermark_;
   long min_credit_assignment_;
   long max_credit_;
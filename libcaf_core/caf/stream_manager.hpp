@@ -20,6 +20,7 @@
 #ifndef CAF_STREAM_MANAGER_HPP
 #define CAF_STREAM_MANAGER_HPP
 
+#include <chrono>
 #include <vector>
 #include <cstdint>
 #include <cstddef>
@@ -34,6 +35,11 @@ namespace caf {
 /// @relates stream_msg
 class stream_manager : public ref_counted {
 public:
+  /// Clock for measuring batch delays.
+  using clock_type = std::chrono::steady_clock;
+
+  stream_manager();
+
   ~stream_manager() override;
 
   /// Handles `stream_msg::open` messages.
@@ -128,6 +134,16 @@ public:
   /// pushed data is limited by the available credit.
   virtual void push();
 
+  /// Returns the point in time at which `out()` must emit its buffered
+  /// elements at the latest, starting a new deadline at `now` if necessary.
+  /// Returns `clock_type::time_point::max()` if `out()` has no buffered
+  /// elements or if it has no `max_batch_delay()`.
+  clock_type::time_point flush_deadline(clock_type::time_point now);
+
+  /// Forces `out()` to emit all buffered elements regardless of the minimum
+  /// batch size if `now` has reached the flush deadline.
+  void flush(clock_type::time_point now);
+
   /// Aborts a stream after any stream message handler returned a non-default
   /// constructed error `reason` or the parent actor terminates with a
   /// non-default error.
@@ -189,6 +205,9 @@ protected:
   /// Pointer to the parent actor.
   local_actor* self_;
 
+  /// Point in time for emitting partially filled batches.
+  clock_type::time_point flush_deadline_;
+
   /// Keeps track of pending handshakes.
   
 };
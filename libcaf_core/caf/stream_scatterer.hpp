@@ -85,9 +85,13 @@ public:
   /// Sets whether this edge remains open after the last path is removed.
   virtual void continuous(bool value) = 0;
 
-  /// Sends batches to sinks.
+  /// Sends batches to sinks. Holds back elements that do not fill a batch of
+  /// at least `min_batch_size()` elements if `max_batch_delay()` is valid.
   virtual void emit_batches() = 0;
 
+  /// Sends batches to sinks regardless of `min_batch_size()`.
+  virtual void force_emit_batches() = 0;
+
   /// Returns the stored state for `x` if `x` is a known path and associated to
   /// `sid`, otherwise `nullptr`.
   virtual path_ptr find(const stream_id& sid, const actor_addr& x) = 0;
@@ -116,8 +120,9 @@ public:
   /// new batches immediately when receiving new downstream demand.
   virtual long min_buffer_size() const = 0;
 
-  /// Forces to actor to emit a batch even if the minimum batch size was not
-  /// reached.
+  /// Forces the actor to emit a batch even if the minimum batch size was not
+  /// reached after buffering elements for this amount of time. An invalid
+  /// duration (the default) disables batch delays.
   virtual duration max_batch_delay() const = 0;
 
   /// Minimum amount of messages required to emit a batch. A value of 0
@@ -132,8 +137,9 @@ public:
   /// new batches immediately when receiving new downstream demand.
   virtual void min_buffer_size(long x) = 0;
 
-  /// Forces to actor to emit a batch even if the minimum batch size was not
-  /// reached.
+  /// Forces the actor to emit a batch even if the minimum batch size was not
+  /// reached after buffering elements for this amount of time. An invalid
+  /// duration disables batch delays.
   virtual void max_batch_delay(duration x) = 0;
 
   // -- convenience functions --------------------------------------------------
@@ -87,6 +87,15 @@ public:
   /// Returns the maximum number of credit in `paths()`.
   long max_credit() const;
 
+  /// Returns the minimum number of elements for emitting a batch, i.e.,
+  /// `min_batch_size()` if batch delays are enabled and `force == false`,
+  /// otherwise 1.
+  long batch_threshold(bool force) const;
+
+  /// Returns `max_batch_size()` if it is positive, otherwise the maximum
+  /// value of `long`.
+  long batch_limit() const;
+
   // -- overridden functions ---------------------------------------------------
 
   void close() override;
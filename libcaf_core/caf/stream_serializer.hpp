@@ -22,6 +22,7 @@
 
 #include <string>
 #include <limits>
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <iomanip>
@@ -177,12 +178,68 @@ protected:
     }
   }
 
+  error apply_builtin_array(builtin type, size_t num, void* vals) override {
+    CAF_ASSERT(vals != nullptr);
+    switch (type) {
+      default: // i8_v or u8_v
+        CAF_ASSERT(type == i8_v || type == u8_v);
+        return apply_raw(num, vals);
+      case i16_v:
+      case u16_v:
+        return apply_int_array(reinterpret_cast<uint16_t*>(vals), num);
+      case i32_v:
+      case u32_v:
+        return apply_int_array(reinterpret_cast<uint32_t*>(vals), num);
+      case i64_v:
+      case u64_v:
+        return apply_int_array(reinterpret_cast<uint64_t*>(vals), num);
+      case float_v:
+        return apply_int_array(reinterpret_cast<float*>(vals), num);
+      case double_v:
+        return apply_int_array(reinterpret_cast<double*>(vals), num);
+    }
+  }
+
   template <class T>
   error apply_int(T x) {
     auto y = detail::to_network_order(x);
     return apply_raw(sizeof(T), &y);
   }
 
+  // Encodes `num` integers or floating points in network byte order. Uses a
+  // scratch buffer to write many values with a single call to `apply_raw`.
+  template <class T>
+  error apply_int_array(const T* xs, size_t num) {
+    using packed = decltype(pack(*xs));
+    packed buf[128];
+    while (num > 0) {
+      auto n = std::min(num, sizeof(buf) / sizeof(packed));
+      for (size_t i = 0; i < n; ++i)
+        buf[i] = detail::to_network_order(pack(xs[i]));
+      auto e = apply_raw(n * sizeof(packed), buf);
+      if (e)
+        return e;
+      xs += n;
+      num -= n;
+    }
+    return none;
+  }
+
+  template <class T>
+  static typename std::enable_if<std::is_integral<T>::value, T>::type
+  pack(T x) {
+    return x;
+  }
+
+  template <class T>
+  static typename std::enable_if<
+    std::is_floating_point<T>::value,
+    typename detail::ieee_754_trait<T>::packed_type
+  >::type
+  pack(T x) {
+    return detail::pack754(x);
+  }
+
 private:
   Streambuf streambuf_;
 };
@@ -81,8 +81,11 @@ protected:
     if (!at_end()) {
       generate_messages();
       push();
+      // don't hold back the last elements of the stream
+      if (at_end())
+        out_.force_emit_batches();
     } else if (out_.buffered() > 0) {
-      push();
+      out_.force_emit_batches();
     } else {
       auto sid = path->sid;
       auto hdl = path->hdl;
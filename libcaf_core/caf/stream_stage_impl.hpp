@@ -104,6 +104,11 @@ protected:
       auto sid = path->sid;
       out_.remove_path(sid, hdl, none, false);
     }
+    // Scatterers that send each element to a subset of sinks only (topic or
+    // partitioned scatterers) can have idle paths that never send demand
+    // again. Hence, we close all paths once we have shipped everything.
+    if (in_.closed() && out_.buffered() == 0)
+      out_.close();
     auto current_size = out_.buffered();
     auto desired_size = out_.credit();
     if (current_size < desired_size)
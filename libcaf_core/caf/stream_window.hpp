@@ -0,0 +1,211 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_STREAM_WINDOW_HPP
+#define CAF_STREAM_WINDOW_HPP
+
+#include <limits>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+#include "caf/config.hpp"
+#include "caf/timestamp.hpp"
+#include "caf/downstream.hpp"
+
+#include "caf/detail/ring_buffer.hpp"
+#include "caf/detail/sliding_aggregator.hpp"
+
+namespace caf {
+
+// -- aggregate functions ------------------------------------------------------
+
+/// Sums up all values of a window. Evicts values by subtracting them.
+template <class T>
+struct sum_aggregate {
+  using value_type = T;
+
+  static constexpr bool invertible = true;
+
+  T identity() const {
+    return T{};
+  }
+
+  T combine(const T& x, const T& y) const {
+    return x + y;
+  }
+
+  T inverse(const T& acc, const T& x) const {
+    return acc - x;
+  }
+};
+
+/// Computes the smallest value of a window.
+template <class T>
+struct min_aggregate {
+  using value_type = T;
+
+  static constexpr bool invertible = false;
+
+  T identity() const {
+    return std::numeric_limits<T>::max();
+  }
+
+  T combine(const T& x, const T& y) const {
+    return y < x ? y : x;
+  }
+};
+
+/// Computes the largest value of a window.
+template <class T>
+struct max_aggregate {
+  using value_type = T;
+
+  static constexpr bool invertible = false;
+
+  T identity() const {
+    return std::numeric_limits<T>::lowest();
+  }
+
+  T combine(const T& x, const T& y) const {
+    return x < y ? y : x;
+  }
+};
+
+// -- windows ------------------------------------------------------------------
+
+/// Aggregates the last `size` elements of a stream and emits the result after
+/// every `slide` elements. Setting `slide` to `size` (the default) results in
+/// tumbling windows. Keeps at most `size` elements and computes aggregates in
+/// amortized constant time per element.
+/// @note Drops incomplete windows at the end of the stream.
+template <class Aggregate>
+class count_window {
+public:
+  using value_type = typename Aggregate::value_type;
+
+  count_window(size_t size = 1, size_t slide = 0, Aggregate f = Aggregate{})
+      : size_(size),
+        slide_(slide > 0 ? slide : size),
+        next_(size),
+        xs_(std::move(f)) {
+    CAF_ASSERT(size > 0);
+  }
+
+  /// Adds `x` to the window and pushes the aggregate to `out` whenever a
+  /// window completes.
+  void operator()(downstream<value_type>& out, value_type x) {
+    // elements between two hopping windows belong to no window at all
+    if (next_ <= size_) {
+      xs_.push(std::move(x));
+      if (xs_.size() > size_)
+        xs_.pop();
+    }
+    if (--next_ == 0) {
+      out.push(xs_.get());
+      next_ = slide_;
+      if (slide_ >= size_)
+        xs_.clear();
+    }
+  }
+
+private:
+  size_t size_;
+  size_t slide_;
+  // number of elements until the next window completes
+  size_t next_;
+  detail::sliding_aggregator<Aggregate> xs_;
+};
+
+/// Aggregates all elements within windows of length `size` that start every
+/// `slide` nanoseconds after the UNIX epoch, based on the timestamps returned
+/// by `TimeFun` for each element. Setting `slide` to `size` (the default)
+/// results in tumbling windows. Emits a window once the first element past
+/// its end arrives and skips empty windows.
+/// @note Expects non-decreasing timestamps and drops elements that arrive
+///       after their window completed.
+/// @note Drops incomplete windows at the end of the stream.
+template <class Aggregate, class TimeFun>
+class time_window {
+public:
+  using value_type = typename Aggregate::value_type;
+
+  time_window(timespan size = timespan{1}, timespan slide = timespan{0},
+              TimeFun f = TimeFun{}, Aggregate g = Aggregate{})
+      : size_(size),
+        slide_(slide.count() > 0 ? slide : size),
+        start_(-1),
+        time_fun_(std::move(f)),
+        xs_(std::move(g)) {
+    CAF_ASSERT(size.count() > 0);
+  }
+
+  /// Adds `x` to the window and pushes the aggregate of each window that
+  /// ends before the timestamp of `x` to `out`.
+  void operator()(downstream<value_type>& out, value_type x) {
+    auto t = std::chrono::duration_cast<timespan>(
+      time_fun_(x).time_since_epoch());
+    if (start_.count() < 0)
+      start_ = first_start(t);
+    while (t >= start_ + size_) {
+      if (!xs_.empty())
+        out.push(xs_.get());
+      start_ += slide_;
+      while (!times_.empty() && times_.front() < start_) {
+        times_.pop_front();
+        xs_.pop();
+      }
+      if (xs_.empty())
+        start_ = std::max(start_, first_start(t));
+    }
+    if (t < start_)
+      return;
+    times_.push_back(t);
+    xs_.push(std::move(x));
+  }
+
+private:
+  // Returns the start of the first window containing `t`.
+  timespan first_start(timespan t) const {
+    if (t < size_)
+      return timespan{0};
+    return ((t - size_) / slide_ + 1) * slide_;
+  }
+
+  timespan size_;
+  timespan slide_;
+  // start of the current window, negative before receiving any element
+  timespan start_;
+  TimeFun time_fun_;
+  detail::ring_buffer<timespan> times_;
+  detail::sliding_aggregator<Aggregate> xs_;
+};
+
+/// Creates a time window that extracts timestamps from elements via `f`.
+/// @relates time_window
+template <class Aggregate, class TimeFun>
+time_window<Aggregate, TimeFun> make_time_window(timespan size, timespan slide,
+                                                 TimeFun f,
+                                                 Aggregate g = Aggregate{}) {
+  return {size, slide, std::move(f), std::move(g)};
+}
+
+} // namespace caf
+
+#endif // CAF_STREAM_WINDOW_HPP
@@ -32,6 +32,9 @@ using timestamp = std::chrono::time_point<
   std::chrono::duration<int64_t, std::nano>
 >;
 
+/// A portable duration with nanosecond resolution.
+using timespan = std::chrono::duration<int64_t, std::nano>;
+
 /// Convenience function for returning a `timestamp` representing
 /// the current system time.
 timestamp make_timestamp();
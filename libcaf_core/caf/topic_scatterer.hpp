@@ -74,6 +74,13 @@ public:
     return false;
   }
 
+  long buffered() const override {
+    auto result = super::buffered();
+    for (auto& kvp : lanes_)
+      result += static_cast<long>(kvp.second.buf.size());
+    return result;
+  }
+
   void add_lane(filter_type f) {
     std::sort(f);
     lanes_.emplace(std::move(f), typename super::buffer_type{});
@@ -79,6 +79,14 @@ std::set<std::string> abstract_actor::message_types() const {
   return std::set<std::string>{};
 }
 
+size_t abstract_actor::mailbox_size_hint() const noexcept {
+  return 0;
+}
+
+void abstract_actor::track_mailbox_size() {
+  // nop
+}
+
 actor_id abstract_actor::id() const noexcept {
   return actor_control_block::from(this)->id();
 }
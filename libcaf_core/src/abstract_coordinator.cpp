@@ -319,6 +319,10 @@ bool abstract_coordinator::detaches_utility_actors() const {
   return true;
 }
 
+abstract_coordinator::clock_type::time_point abstract_coordinator::now() const {
+  return clock_type::now();
+}
+
 void abstract_coordinator::start() {
   CAF_LOG_TRACE("");
   // launch utility actors
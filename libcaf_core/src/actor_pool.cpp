@@ -19,8 +19,8 @@
 
 #include "caf/actor_pool.hpp"
 
-#include <atomic>
 #include <random>
+#include <algorithm>
 
 #include "caf/send.hpp"
 #include "caf/default_attachable.hpp"
@@ -29,98 +29,109 @@
 
 namespace caf {
 
-actor_pool::policy actor_pool::round_robin() {
-  struct impl {
-    impl() : pos_(0) {
-      // nop
-    }
-    impl(const impl&) : pos_(0) {
-      // nop
-    }
-    void operator()(actor_system&, uplock& guard, const actor_vec& vec,
-                    mailbox_element_ptr& ptr, execution_unit* host) {
-      CAF_ASSERT(!vec.empty());
-      actor selected = vec[pos_++ % vec.size()];
-      guard.unlock();
-      selected->enqueue(std::move(ptr), host);
-    }
-    std::atomic<size_t> pos_;
-  };
-  return impl{};
-}
+namespace detail {
 
-namespace {
+random_policy::random_policy() : state_(std::random_device{}()) {
+  // nop
+}
 
-void broadcast_dispatch(actor_system&, actor_pool::uplock&,
-                        const actor_pool::actor_vec& vec,
-                        mailbox_element_ptr& ptr, execution_unit* host) {
-  CAF_ASSERT(!vec.empty());
-  auto msg = ptr->move_content_to_message();
-  for (auto& worker : vec)
-    worker->enqueue(ptr->sender, ptr->mid, msg, host);
+random_policy::random_policy(const random_policy&)
+    : state_(std::random_device{}()) {
+  // nop
 }
 
-} // namespace <anonymous>
+power_of_two_policy::power_of_two_policy()
+    : state_(std::random_device{}()) {
+  // nop
+}
 
-actor_pool::policy actor_pool::broadcast() {
-  return broadcast_dispatch;
+power_of_two_policy::power_of_two_policy(const power_of_two_policy&)
+    : state_(std::random_device{}()) {
+  // nop
 }
 
-actor_pool::policy actor_pool::random() {
-  struct impl {
-    impl() : rd_() {
-      // nop
-    }
-    impl(const impl&) : rd_() {
-      // nop
-    }
-    void operator()(actor_system&, uplock& guard, const actor_vec& vec,
-                    mailbox_element_ptr& ptr, execution_unit* host) {
-      upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-      auto selected =
-          vec[dis_(rd_, decltype(dis_)::param_type(0, vec.size() - 1))];
-      unique_guard.unlock();
-      selected->enqueue(std::move(ptr), host);
-    }
-    std::random_device rd_;
-    std::uniform_int_distribution<size_t> dis_;
-  };
-  return impl{};
+void track_mailbox_sizes(const std::vector<actor>& workers) {
+  for (auto& worker : workers)
+    worker->track_mailbox_size();
 }
 
-actor_pool::~actor_pool() {
-  // nop
+size_t jump_consistent_hash(uint64_t key, size_t num_buckets) {
+  int64_t b = -1;
+  int64_t j = 0;
+  while (j < static_cast<int64_t>(num_buckets)) {
+    b = j;
+    key = key * 2862933555777941757ull + 1;
+    j = static_cast<int64_t>((b + 1) * (static_cast<double>(1ll << 31)
+                                        / static_cast<double>((key >> 33) + 1)));
+  }
+  return static_cast<size_t>(b);
 }
 
-actor actor_pool::make(execution_unit* eu, policy pol) {
-  CAF_ASSERT(eu);
-  auto& sys = eu->system();
-  actor_config cfg{eu};
-  auto res = make_actor<actor_pool, actor>(sys.next_actor_id(), sys.node(),
-                                           &sys, cfg);
-  auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
-  ptr->policy_ = std::move(pol);
-  return res;
-}
-
-actor actor_pool::make(execution_unit* eu, size_t num_workers,
-                       const factory& fac, policy pol) {
-  auto res = make(eu, std::move(pol));
-  auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
-  auto res_addr = ptr->address();
-  for (size_t i = 0; i < num_workers; ++i) {
-    auto worker = fac();
-    worker->attach(default_attachable::make_monitor(worker.address(), res_addr));
-    ptr->workers_.push_back(std::move(worker));
+hash_ring make_hash_ring(const std::vector<actor>& workers,
+                         size_t virtual_nodes) {
+  hash_ring result;
+  result.reserve(workers.size() * virtual_nodes);
+  for (auto& worker : workers) {
+    auto seed = mix64(static_cast<uint64_t>(worker->id()))
+                ^ static_cast<uint64_t>(std::hash<node_id>{}(worker->node()));
+    for (size_t i = 0; i < virtual_nodes; ++i)
+      result.emplace_back(mix64(seed + i * 0x9E3779B97F4A7C15ull), worker);
   }
-  return res;
+  std::sort(result.begin(), result.end(),
+            [](const hash_ring::value_type& x, const hash_ring::value_type& y) {
+              return x.first < y.first;
+            });
+  return result;
+}
+
+const actor& hash_ring_lookup(const hash_ring& xs, uint64_t key) {
+  CAF_ASSERT(!xs.empty());
+  auto i = std::lower_bound(xs.begin(), xs.end(), key,
+                            [](const hash_ring::value_type& x, uint64_t y) {
+                              return x.first < y;
+                            });
+  return i != xs.end() ? i->second : xs.front().second;
+}
+
+} // namespace detail
+
+detail::round_robin_policy actor_pool::round_robin() {
+  return {};
+}
+
+detail::broadcast_policy actor_pool::broadcast() {
+  return {};
 }
 
-void actor_pool::enqueue(mailbox_element_ptr what, execution_unit* eu) {
-  upgrade_lock<detail::shared_spinlock> guard{workers_mtx_};
-  if (filter(guard, what->sender, what->mid, *what, eu))
-    return;
-  policy_(home_system(), guard, workers_, what, eu);
+detail::random_policy actor_pool::random() {
+  return {};
+}
+
+detail::least_loaded_policy actor_pool::least_loaded() {
+  return {};
+}
+
+detail::power_of_two_policy actor_pool::power_of_two() {
+  return {};
+}
+
+actor_pool::~actor_pool() {
+  // nop
+}
+
+void actor_pool::add_workers(const actor& pool, size_t num_workers,
+                             const factory& fac) {
+  auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(pool));
+  auto pool_addr = ptr->address();
+  ptr->update_workers([&](actor_vec& workers) {
+    workers.reserve(workers.size() + num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+      auto worker = fac();
+      worker->attach(default_attachable::make_monitor(worker.address(),
+                                                      pool_addr));
+      workers.push_back(std::move(worker));
+    }
+  });
 }
 
 actor_pool::actor_pool(actor_config& cfg) : monitorable_actor(cfg) {
@@ -131,22 +142,22 @@ void actor_pool::on_cleanup() {
   // nop
 }
 
-bool actor_pool::filter(upgrade_lock<detail::shared_spinlock>& guard,
-                        const strong_actor_ptr& sender, message_id mid,
-                        message_view& mv, execution_unit* eu) {
-  auto& content = mv.content();
-  CAF_LOG_TRACE(CAF_ARG(mid) << CAF_ARG(content));
+void actor_pool::workers_changed(const actor_vec&) {
+  // nop
+}
+
+bool actor_pool::filter(mailbox_element_ptr& what, execution_unit* eu) {
+  auto& content = what->content();
+  CAF_LOG_TRACE(CAF_ARG(what->mid) << CAF_ARG(content));
   if (content.match_elements<exit_msg>()) {
-    // acquire second mutex as well
-    std::vector<actor> workers;
     auto em = content.get_as<exit_msg>(0).reason;
     if (cleanup(std::move(em), eu)) {
-      auto tmp = mv.move_content_to_message();
+      auto tmp = what->move_content_to_message();
       // send exit messages *always* to all workers and clear vector afterwards
-      // but first swap workers_ out of the critical section
-      upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-      workers_.swap(workers);
-      unique_guard.unlock();
+      std::vector<actor> workers;
+      update_workers([&](actor_vec& xs) {
+        xs.swap(workers);
+      });
       for (auto& w : workers)
         anon_send(w, tmp);
       unregister_from_system();
@@ -156,15 +167,18 @@ bool actor_pool::filter(upgrade_lock<detail::shared_spinlock>& guard,
   if (content.match_elements<down_msg>()) {
     // remove failed worker from pool
     auto& dm = content.get_as<down_msg>(0);
-    upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-    auto last = workers_.end();
-    auto i = std::find(workers_.begin(), workers_.end(), dm.source);
-    CAF_LOG_DEBUG_IF(i == last, "received down message for an unknown worker");
-    if (i != last)
-      workers_.erase(i);
-    if (workers_.empty()) {
+    bool out_of_workers = false;
+    update_workers([&](actor_vec& xs) {
+      auto last = xs.end();
+      auto i = std::find(xs.begin(), last, dm.source);
+      CAF_LOG_DEBUG_IF(i == last,
+                       "received down message for an unknown worker");
+      if (i != last)
+        xs.erase(i);
+      out_of_workers = xs.empty();
+    });
+    if (out_of_workers) {
       planned_reason_ = exit_reason::out_of_workers;
-      unique_guard.unlock();
       quit(eu);
     }
     return true;
@@ -173,55 +187,56 @@ bool actor_pool::filter(upgrade_lock<detail::shared_spinlock>& guard,
     auto& worker = content.get_as<actor>(2);
     worker->attach(default_attachable::make_monitor(worker.address(),
                                                     address()));
-    upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-    workers_.push_back(worker);
+    update_workers([&](actor_vec& xs) {
+      xs.push_back(worker);
+    });
     return true;
   }
   if (content.match_elements<sys_atom, delete_atom, actor>()) {
-    upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-    auto& what = content.get_as<actor>(2);
-    auto last = workers_.end();
-    auto i = std::find(workers_.begin(), last, what);
-    if (i != last) {
-      default_attachable::observe_token tk{address(),
-                                           default_attachable::monitor};
-      what->detach(tk);
-      workers_.erase(i);
-    }
+    auto& x = content.get_as<actor>(2);
+    update_workers([&](actor_vec& xs) {
+      auto last = xs.end();
+      auto i = std::find(xs.begin(), last, x);
+      if (i != last) {
+        default_attachable::observe_token tk{address(),
+                                             default_attachable::monitor};
+        x->detach(tk);
+        xs.erase(i);
+      }
+    });
     return true;
   }
   if (content.match_elements<sys_atom, delete_atom>()) {
-    upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-    for (auto& worker : workers_) {
-      default_attachable::observe_token tk{address(),
-                                           default_attachable::monitor};
-      worker->detach(tk);
-    }
-    workers_.clear();
+    update_workers([&](actor_vec& xs) {
+      for (auto& worker : xs) {
+        default_attachable::observe_token tk{address(),
+                                             default_attachable::monitor};
+        worker->detach(tk);
+      }
+      xs.clear();
+    });
     return true;
   }
   if (content.match_elements<sys_atom, get_atom>()) {
-    auto cpy = workers_;
-    guard.unlock();
-    sender->enqueue(nullptr, mid.response_id(),
-                    make_message(std::move(cpy)), eu);
-    return true;
-  }
-  if (workers_.empty()) {
-    guard.unlock();
-    if (sender && mid.valid()) {
-      // tell client we have ignored this sync message by sending
-      // and empty message back
-      sender->enqueue(nullptr, mid.response_id(), message{}, eu);
-    }
+    actor_vec cpy = *workers_.read();
+    what->sender->enqueue(nullptr, what->mid.response_id(),
+                          make_message(std::move(cpy)), eu);
     return true;
   }
   return false;
 }
 
+void actor_pool::bounce(mailbox_element_ptr& what, execution_unit* eu) {
+  if (what->sender && what->mid.valid()) {
+    // tell client we have ignored this sync message by sending
+    // and empty message back
+    what->sender->enqueue(nullptr, what->mid.response_id(), message{}, eu);
+  }
+}
+
 void actor_pool::quit(execution_unit* host) {
-  // we can safely run our cleanup code here without holding
-  // workers_mtx_ because abstract_actor has its own lock
+  // we can safely run our cleanup code here without accessing
+  // workers_ because abstract_actor has its own lock
   if (cleanup(planned_reason_, host))
     unregister_from_system();
 }
@@ -125,6 +125,11 @@ actor_system_config::actor_system_config()
   work_stealing_moderate_sleep_duration_us = 50;
   work_stealing_relaxed_steal_interval = 1;
   work_stealing_relaxed_sleep_duration_us = 10000;
+  local_groups_fan_out_threshold = 4096;
+  stream_credit_policy = atom("fixed");
+  stream_credit_time_budget_us = 10000;
+  stream_batch_time_budget_us = 1000;
+  stream_max_credit = 10000;
   logger_file_name = "actor_log_[PID]_[TIMESTAMP]_[NODE].log";
   logger_file_format = "%r %c %p %a %t %C %M %F:%L %m%n";
   logger_console = atom("none");
@@ -137,6 +142,7 @@ actor_system_config::actor_system_config()
   middleman_heartbeat_interval = 0;
   middleman_detach_utility_actors = true;
   middleman_detach_multiplexer = true;
+  middleman_max_pending_stream_bytes = 1048576;
   // fill our options vector for creating INI and CLI parsers
   opt_group{options_, "scheduler"}
   .add(scheduler_policy, "policy",
@@ -166,6 +172,18 @@ actor_system_config::actor_system_config()
        "sets the frequency of steal attempts during relaxed polling")
   .add(work_stealing_relaxed_sleep_duration_us, "relaxed-sleep-duration",
        "sets the sleep interval between poll attempts during relaxed polling");
+  opt_group{options_, "local-groups"}
+  .add(local_groups_fan_out_threshold, "fan-out-threshold",
+       "sets the minimum number of subscribers for parallel delivery (0 = off)");
+  opt_group{options_, "stream"}
+  .add(stream_credit_policy, "credit-policy",
+       "sets the credit policy of sinks to either 'fixed' or 'throughput'")
+  .add(stream_credit_time_budget_us, "credit-time-budget",
+       "sets the desired processing time (us) of all credit on a path")
+  .add(stream_batch_time_budget_us, "batch-time-budget",
+       "sets the desired processing time (us) of a single batch")
+  .add(stream_max_credit, "max-credit",
+       "sets the maximum credit per path for the throughput credit policy");
   opt_group{options_, "logger"}
   .add(logger_file_name, "file-name",
        "sets the filesystem path of the log file")
@@ -199,7 +217,9 @@ actor_system_config::actor_system_config()
   .add(middleman_detach_utility_actors, "detach-utility-actors",
        "enables or disables detaching of utility actors")
   .add(middleman_detach_multiplexer, "detach-multiplexer",
-       "enables or disables background activity of the multiplexer");
+       "enables or disables background activity of the multiplexer")
+  .add(middleman_max_pending_stream_bytes, "max-pending-stream-bytes",
+       "sets the maximum of unsent bytes before holding back stream credit");
   opt_group(options_, "opencl")
   .add(opencl_device_ids, "device-ids",
        "restricts which OpenCL devices are accessed by CAF");
@@ -246,6 +266,11 @@ actor_system_config::actor_system_config(actor_system_config&& other)
         other.work_stealing_relaxed_steal_interval),
       work_stealing_relaxed_sleep_duration_us(
         other.work_stealing_relaxed_sleep_duration_us),
+      local_groups_fan_out_threshold(other.local_groups_fan_out_threshold),
+      stream_credit_policy(other.stream_credit_policy),
+      stream_credit_time_budget_us(other.stream_credit_time_budget_us),
+      stream_batch_time_budget_us(other.stream_batch_time_budget_us),
+      stream_max_credit(other.stream_max_credit),
       logger_file_name(std::move(other.logger_file_name)),
       logger_file_format(std::move(other.logger_file_format)),
       logger_console(other.logger_console),
@@ -263,6 +288,8 @@ actor_system_config::actor_system_config(actor_system_config&& other)
       middleman_heartbeat_interval(other.middleman_heartbeat_interval),
       middleman_detach_utility_actors(other.middleman_detach_utility_actors),
       middleman_detach_multiplexer(other.middleman_detach_multiplexer),
+      middleman_max_pending_stream_bytes(
+        other.middleman_max_pending_stream_bytes),
       opencl_device_ids(std::move(other.opencl_device_ids)),
       openssl_certificate(std::move(other.openssl_certificate)),
       openssl_key(std::move(other.openssl_key)),
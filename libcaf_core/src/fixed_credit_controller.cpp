@@ -0,0 +1,50 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/fixed_credit_controller.hpp"
+
+#include "caf/stream_gatherer.hpp"
+
+namespace caf {
+namespace detail {
+
+fixed_credit_controller::fixed_credit_controller(const stream_gatherer* parent)
+    : credit_controller(false),
+      parent_(parent) {
+  // nop
+}
+
+fixed_credit_controller::~fixed_credit_controller() {
+  // nop
+}
+
+void fixed_credit_controller::batch_processed(long, timespan, timespan) {
+  // nop
+}
+
+long fixed_credit_controller::max_credit() const {
+  return parent_->max_credit();
+}
+
+long fixed_credit_controller::batch_size() const {
+  return parent_->min_credit_assignment();
+}
+
+} // namespace detail
+} // namespace caf
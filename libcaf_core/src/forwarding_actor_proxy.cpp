@@ -83,6 +83,11 @@ bool forwarding_actor_proxy::remove_backlink(abstract_actor* x) {
   return false;
 }
 
+actor forwarding_actor_proxy::manager() const {
+  shared_lock<detail::shared_spinlock> guard(mtx_);
+  return broker_;
+}
+
 void forwarding_actor_proxy::kill_proxy(execution_unit* ctx, error rsn) {
   CAF_ASSERT(ctx != nullptr);
   actor tmp;
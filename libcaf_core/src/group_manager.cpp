@@ -18,7 +18,13 @@
  ******************************************************************************/
 
 #include <set>
+#include <array>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <condition_variable>
@@ -34,6 +40,10 @@
 
 #include "caf/group_manager.hpp"
 
+#include "caf/detail/rcu_ptr.hpp"
+#include "caf/detail/multicast.hpp"
+#include "caf/detail/topic_trie.hpp"
+
 namespace caf {
 
 namespace {
@@ -46,7 +56,7 @@ using upgrade_to_unique_guard = upgrade_to_unique_lock<detail::shared_spinlock>;
 class local_broker;
 class local_group_module;
 
-void await_all_locals_down(actor_system& sys, std::initializer_list<actor> xs) {
+void await_all_locals_down(actor_system& sys, const std::vector<actor>& xs) {
   CAF_LOG_TRACE("");
   scoped_actor self{sys, true};
   std::vector<actor> ys;
@@ -58,14 +68,117 @@ void await_all_locals_down(actor_system& sys, std::initializer_list<actor> xs) {
   self->wait_for(ys);
 }
 
+// Subscribers of a local group, distributed over a fixed number of shards.
+// Each shard is a sorted, copy-on-write vector, i.e., publishers never lock
+// and subscribe/unsubscribe only contends with other writers on the same
+// shard. A bitmask of non-empty shards allows publishers to skip empty
+// shards, i.e., small groups only pay for the shards they actually use.
+class local_group_shards {
+public:
+  static constexpr size_t num_shards = 16;
+
+  using subscriber_vec = std::vector<strong_actor_ptr>;
+
+  local_group_shards() : size_(0), non_empty_(0) {
+    // nop
+  }
+
+  // returns the number of subscribers
+  size_t size() const {
+    return size_.load();
+  }
+
+  // returns a bitmask with bit `i` set if shard `i` has subscribers
+  uint32_t non_empty() const {
+    return non_empty_.load();
+  }
+
+  void send(size_t shard, const strong_actor_ptr& sender, const message& msg,
+            execution_unit* host) const {
+    CAF_ASSERT(shard < num_shards);
+    auto xs = shards_[shard].read();
+    for (auto& x : *xs)
+      x->enqueue(sender, invalid_message_id, msg, host);
+  }
+
+  std::pair<bool, size_t> add(strong_actor_ptr who) {
+    std::pair<bool, size_t> result{false, 0};
+    auto ptr = who.get();
+    auto shard = shard_of(ptr);
+    shards_[shard].update([&](subscriber_vec& xs) {
+      auto i = std::lower_bound(xs.begin(), xs.end(), ptr, less_by_ptr);
+      if (i != xs.end() && i->get() == ptr) {
+        result.second = size_.load();
+        return;
+      }
+      xs.insert(i, std::move(who));
+      non_empty_.fetch_or(1u << shard);
+      result.first = true;
+      result.second = size_.fetch_add(1) + 1;
+    });
+    return result;
+  }
+
+  std::pair<bool, size_t> erase(const actor_control_block* who) {
+    std::pair<bool, size_t> result{false, 0};
+    auto shard = shard_of(who);
+    shards_[shard].update([&](subscriber_vec& xs) {
+      auto i = std::lower_bound(xs.begin(), xs.end(), who, less_by_ptr);
+      if (i == xs.end() || i->get() != who) {
+        result.second = size_.load();
+        return;
+      }
+      xs.erase(i);
+      if (xs.empty())
+        non_empty_.fetch_and(~(1u << shard));
+      result.first = true;
+      result.second = size_.fetch_sub(1) - 1;
+    });
+    return result;
+  }
+
+private:
+  static bool less_by_ptr(const strong_actor_ptr& x,
+                          const actor_control_block* y) {
+    return x.get() < y;
+  }
+
+  static size_t shard_of(const actor_control_block* x) {
+    // Fibonacci hashing, using the upper bits of the product
+    auto h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(x))
+             * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) % num_shards;
+  }
+
+  std::array<detail::rcu_ptr<subscriber_vec>, num_shards> shards_;
+  std::atomic<size_t> size_;
+  std::atomic<uint32_t> non_empty_;
+};
+
+constexpr size_t local_group_shards::num_shards;
+
+using local_group_shards_ptr = std::shared_ptr<local_group_shards>;
+
+// Groups with at least `local_groups_fan_out_threshold` subscribers deliver
+// messages in parallel by handing each shard to a hidden helper actor. Each
+// helper delivers messages for its shard in arrival order. Once spawned, the
+// helpers deliver all messages of the group, since messages sent directly
+// could otherwise overtake messages still waiting in a helper's mailbox.
 class local_group : public abstract_group {
 public:
+  static constexpr size_t num_shards = local_group_shards::num_shards;
+
   void send_all_subscribers(const strong_actor_ptr& sender, const message& msg,
                             execution_unit* host) {
     CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(msg));
-    shared_guard guard(mtx_);
-    for (auto& s : subscribers_)
-      s->enqueue(sender, invalid_message_id, msg, host);
+    if ((fan_out_state_.load() == 1
+         || (fan_out_threshold_ > 0 && shards_->size() >= fan_out_threshold_))
+        && fan_out(sender, msg, host))
+      return;
+    auto mask = shards_->non_empty();
+    for (size_t i = 0; i < num_shards; ++i)
+      if ((mask & (1u << i)) != 0)
+        shards_->send(i, sender, msg, host);
   }
 
   void enqueue(strong_actor_ptr sender, message_id, message msg,
@@ -78,28 +191,13 @@ public:
   std::pair<bool, size_t> add_subscriber(strong_actor_ptr who) {
     CAF_LOG_TRACE(CAF_ARG(who));
     if (!who)
-      return {false, subscribers_.size()};
-    exclusive_guard guard(mtx_);
-    auto res = subscribers_.emplace(std::move(who)).second;
-    return {res, subscribers_.size()};
+      return {false, shards_->size()};
+    return shards_->add(std::move(who));
   }
 
   std::pair<bool, size_t> erase_subscriber(const actor_control_block* who) {
     CAF_LOG_TRACE(""); // serializing who would cause a deadlock
-    exclusive_guard guard(mtx_);
-    auto e = subscribers_.end();
-#if __cplusplus > 201103L
-    auto i = subscribers_.find(who);
-#else
-    auto cmp = [&](const strong_actor_ptr& lhs) {
-      return lhs.get() == who;
-    };
-    auto i = std::find_if(subscribers_.begin(), e, cmp);
-#endif
-    if(i == e)
-      return {false, subscribers_.size()};
-    subscribers_.erase(i);
-    return {true, subscribers_.size()};
+    return shards_->erase(who);
   }
 
   bool subscribe(strong_actor_ptr who) override {
@@ -117,6 +215,7 @@ public:
   void stop() override {
     CAF_LOG_TRACE("");
     await_all_locals_down(system(), {broker_});
+    stop_fan_out();
   }
 
   const actor& broker() const {
@@ -129,13 +228,21 @@ public:
   ~local_group() override;
 
 protected:
-  detail::shared_spinlock mtx_;
-#if __cplusplus > 201103L
-  std::set<strong_actor_ptr, std::less<>> subscribers_;
-#else
-  std::set<strong_actor_ptr> subscribers_;
-#endif
+  // spawns helpers on first use and dispatches `msg` to them, returns
+  // `false` if the group has already been stopped
+  bool fan_out(const strong_actor_ptr& sender, const message& msg,
+               execution_unit* host);
+
+  void stop_fan_out();
+
+  // shared with the fan-out helpers, which must not keep the group alive
+  local_group_shards_ptr shards_;
+  size_t fan_out_threshold_;
   actor broker_;
+  // 0 = no helpers, 1 = running, 2 = stopped
+  std::atomic<int> fan_out_state_;
+  std::mutex fan_out_mtx_;
+  std::vector<actor> fan_out_helpers_;
 };
 
 using local_group_ptr = intrusive_ptr<local_group>;
@@ -144,12 +251,14 @@ class local_broker : public event_based_actor {
 public:
   explicit local_broker(actor_config& cfg, local_group_ptr g)
       : event_based_actor(cfg),
-        group_(std::move(g)) {
+        group_(std::move(g)),
+        plan_valid_(false) {
     // nop
   }
 
   void on_exit() override {
     acquaintances_.clear();
+    plan_ = detail::multicast_plan{};
     group_.reset();
   }
 
@@ -173,8 +282,10 @@ public:
       auto i = std::find_if(first, last, [&](const actor& a) {
         return a == dm.source;
       });
-      if (i != last)
+      if (i != last) {
         acquaintances_.erase(i);
+        plan_valid_ = false;
+      }
     });
     // return behavior
     return {
@@ -182,13 +293,15 @@ public:
         CAF_LOG_TRACE(CAF_ARG(other));
         if (acquaintances_.insert(other).second) {
           monitor(other);
+          plan_valid_ = false;
         }
       },
       [=](leave_atom, const actor& other) {
         CAF_LOG_TRACE(CAF_ARG(other));
-        acquaintances_.erase(other);
-        if (acquaintances_.erase(other) > 0)
+        if (acquaintances_.erase(other) > 0) {
           demonitor(other);
+          plan_valid_ = false;
+        }
       },
       [=](forward_atom, const message& what) {
         CAF_LOG_TRACE(CAF_ARG(what));
@@ -206,12 +319,64 @@ private:
     auto src = current_element_->sender;
     CAF_LOG_DEBUG(CAF_ARG(acquaintances_.size())
                   << CAF_ARG(src) << CAF_ARG(what));
-    for (auto& acquaintance : acquaintances_)
-      acquaintance->enqueue(src, invalid_message_id, what, context());
+    // serialize `what` only once for all remote nodes and group the
+    // acquaintances by their manager only after they have changed
+    if (!plan_valid_) {
+      std::vector<strong_actor_ptr> receivers;
+      receivers.reserve(acquaintances_.size());
+      for (auto& acquaintance : acquaintances_)
+        receivers.emplace_back(actor_cast<strong_actor_ptr>(acquaintance));
+      plan_ = detail::multicast_plan{receivers};
+      plan_valid_ = true;
+    }
+    plan_.send(src, what, context());
   }
 
   local_group_ptr group_;
   std::set<actor> acquaintances_;
+  detail::multicast_plan plan_;
+  bool plan_valid_;
+};
+
+// Delivers messages to the subscribers of a single shard of a local group.
+// Holds on to the shards instead of the group in order to avoid a cycle
+// between the group and its helpers.
+class local_group_fan_out : public event_based_actor {
+public:
+  local_group_fan_out(actor_config& cfg, local_group_shards_ptr xs,
+                      size_t shard)
+      : event_based_actor(cfg),
+        shards_(std::move(xs)),
+        shard_(shard) {
+    // nop
+  }
+
+  void on_exit() override {
+    shards_.reset();
+  }
+
+  const char* name() const override {
+    return "local_group_fan_out";
+  }
+
+  behavior make_behavior() override {
+    CAF_LOG_TRACE("");
+    auto fwd = [=](scheduled_actor*, message_view& x) -> result<message> {
+      shards_->send(shard_, current_element_->sender,
+                    x.move_content_to_message(), context());
+      return message{};
+    };
+    set_default_handler(fwd);
+    return {
+      [=] {
+        shards_->send(shard_, current_element_->sender, message{}, context());
+      }
+    };
+  }
+
+private:
+  local_group_shards_ptr shards_;
+  size_t shard_;
 };
 
 // Send a join message to the original group if a proxy
@@ -284,6 +449,7 @@ public:
   void stop() override {
     CAF_LOG_TRACE("");
     await_all_locals_down(system_, {monitor_, proxy_broker_, broker_});
+    stop_fan_out();
   }
 
 private:
@@ -419,10 +585,46 @@ private:
 local_group::local_group(local_group_module& mod, std::string id, node_id nid,
                          optional<actor> lb)
     : abstract_group(mod, std::move(id), std::move(nid)),
-      broker_(lb ? *lb : mod.system().spawn<local_broker, hidden>(this)) {
+      shards_(std::make_shared<local_group_shards>()),
+      fan_out_threshold_(mod.system().config().local_groups_fan_out_threshold),
+      broker_(lb ? *lb : mod.system().spawn<local_broker, hidden>(this)),
+      fan_out_state_(0) {
   CAF_LOG_TRACE(CAF_ARG(id) << CAF_ARG(nid));
 }
 
+bool local_group::fan_out(const strong_actor_ptr& sender, const message& msg,
+                          execution_unit* host) {
+  if (fan_out_state_.load() != 1) {
+    std::unique_lock<std::mutex> guard{fan_out_mtx_};
+    if (fan_out_state_.load() == 2)
+      return false;
+    if (fan_out_state_.load() == 0) {
+      CAF_LOG_DEBUG("spawn fan-out helpers:" << CAF_ARG(shards_->size()));
+      for (size_t i = 0; i < num_shards; ++i)
+        fan_out_helpers_.push_back(
+          system().spawn<local_group_fan_out, hidden>(shards_, i));
+      fan_out_state_ = 1;
+    }
+  }
+  // the vector of helpers remains unchanged while the state is 1
+  auto mask = shards_->non_empty();
+  for (size_t i = 0; i < num_shards; ++i)
+    if ((mask & (1u << i)) != 0)
+      fan_out_helpers_[i]->enqueue(sender, invalid_message_id, msg, host);
+  return true;
+}
+
+void local_group::stop_fan_out() {
+  CAF_LOG_TRACE("");
+  { // critical section
+    std::unique_lock<std::mutex> guard{fan_out_mtx_};
+    fan_out_state_ = 2;
+  }
+  // publishers may still iterate the helpers, hence we must not modify
+  // the vector itself here
+  await_all_locals_down(system(), fan_out_helpers_);
+}
+
 local_group::~local_group() {
   // nop
 }
@@ -434,6 +636,548 @@ error local_group::save(serializer& sink) const {
   return static_cast<local_group_module&>(parent_).save(this, sink);
 }
 
+// -- topic groups -------------------------------------------------------------
+
+// Topic groups use the group identifier as hierarchical topic. Subscribing to
+// a topic group subscribes to its identifier as pattern (see `topic_trie`),
+// publishing to a topic group delivers to all subscribers with a matching
+// pattern. Each node runs a single topic broker that accepts subscriptions
+// from remote nodes, i.e., only matching messages cross the network. Each
+// node subscribes via a single proxy broker per remote topic broker and thus
+// receives each message only once, even if several of its patterns match.
+
+class topic_group_module;
+
+// Receivers matching a topic for a given version of the topic.
+struct topic_match {
+  size_t version;
+  // local subscribers, receiving published messages as is
+  detail::multicast_plan subscribers;
+  // proxy brokers of remote nodes, receiving `(forward_atom, topic, msg)`
+  detail::multicast_plan nodes;
+};
+
+void publish(const topic_match& x, const std::string& topic,
+             const strong_actor_ptr& sender, const message& msg,
+             execution_unit* host) {
+  x.subscribers.send(sender, msg, host);
+  if (!x.nodes.empty())
+    x.nodes.send(sender, make_message(forward_atom::value, topic, msg), host);
+}
+
+using topic_match_ptr = std::shared_ptr<const topic_match>;
+
+class topic_group : public abstract_group {
+public:
+  topic_group(topic_group_module& mod, std::string id, node_id nid,
+              actor broker);
+
+  ~topic_group() override;
+
+  void enqueue(strong_actor_ptr sender, message_id, message msg,
+               execution_unit* host) override;
+
+  bool subscribe(strong_actor_ptr who) override;
+
+  void unsubscribe(const actor_control_block* who) override;
+
+  error save(serializer& sink) const override;
+
+  void stop() override {
+    // nop
+  }
+
+  const actor& broker() const {
+    return broker_;
+  }
+
+  // drops the cached subscribers after a matching pattern changed
+  void invalidate() {
+    ++version_;
+  }
+
+protected:
+  topic_group_module& module() const;
+
+  actor broker_;
+
+private:
+  bool is_pattern_;
+  std::atomic<size_t> version_;
+  // accessed via std::atomic_load and std::atomic_store
+  topic_match_ptr cache_;
+};
+
+using topic_group_ptr = intrusive_ptr<topic_group>;
+
+class topic_group_proxy;
+
+using topic_group_proxy_ptr = intrusive_ptr<topic_group_proxy>;
+
+// Receives all messages from a remote topic broker on behalf of the local
+// proxies for this broker and delivers them to the subscribers of all proxies
+// with a matching pattern.
+class topic_proxy_broker : public event_based_actor {
+public:
+  topic_proxy_broker(actor_config& cfg, actor remote_broker)
+      : event_based_actor(cfg),
+        remote_broker_(std::move(remote_broker)) {
+    // nop
+  }
+
+  const char* name() const override {
+    return "topic_proxy_broker";
+  }
+
+  void on_exit() override {
+    proxies_.clear();
+  }
+
+  behavior make_behavior() override;
+
+private:
+  actor remote_broker_;
+  std::map<std::string, topic_group_proxy_ptr> proxies_;
+};
+
+class topic_group_proxy : public topic_group {
+public:
+  topic_group_proxy(topic_group_module& mod, std::string id,
+                    actor remote_broker, actor proxy_broker);
+
+  // Join and leave messages for the proxy broker go out while holding the
+  // write lock of `subscribers_`, i.e., in the same order as the updates.
+
+  bool subscribe(strong_actor_ptr who) override {
+    CAF_LOG_TRACE(CAF_ARG(who));
+    if (!who)
+      return false;
+    auto ptr = who.get();
+    bool added = false;
+    subscribers_.update([&](subscriber_vec& xs) {
+      if (std::find(xs.begin(), xs.end(), ptr) != xs.end())
+        return;
+      xs.push_back(std::move(who));
+      added = true;
+      // subscribe at the remote node for our first local subscriber
+      if (xs.size() == 1)
+        anon_send(proxy_broker_, join_atom::value, identifier_, group{this});
+    });
+    return added;
+  }
+
+  void unsubscribe(const actor_control_block* who) override {
+    CAF_LOG_TRACE(CAF_ARG(who));
+    subscribers_.update([&](subscriber_vec& xs) {
+      auto i = std::find(xs.begin(), xs.end(), who);
+      if (i == xs.end())
+        return;
+      xs.erase(i);
+      if (xs.empty())
+        anon_send(proxy_broker_, leave_atom::value, identifier_);
+    });
+  }
+
+  void enqueue(strong_actor_ptr sender, message_id,
+               message msg, execution_unit* eu) override {
+    CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(msg));
+    // the remote broker matches the topic against its subscriptions
+    broker_->enqueue(std::move(sender), invalid_message_id,
+                     make_message(forward_atom::value, identifier_,
+                                  std::move(msg)),
+                     eu);
+  }
+
+  void append_subscribers(std::vector<strong_actor_ptr>& result) const {
+    auto xs = subscribers_.read();
+    result.insert(result.end(), xs->begin(), xs->end());
+  }
+
+  void send_all_subscribers(const strong_actor_ptr& sender, const message& msg,
+                            execution_unit* host) {
+    auto xs = subscribers_.read();
+    for (auto& x : *xs)
+      x->enqueue(sender, invalid_message_id, msg, host);
+  }
+
+private:
+  using subscriber_vec = std::vector<strong_actor_ptr>;
+
+  detail::rcu_ptr<subscriber_vec> subscribers_;
+  actor proxy_broker_;
+};
+
+behavior topic_proxy_broker::make_behavior() {
+  CAF_LOG_TRACE("");
+  monitor(remote_broker_);
+  set_down_handler([=](down_msg& dm) {
+    CAF_LOG_TRACE(CAF_ARG(dm));
+    if (remote_broker_ == dm.source) {
+      for (auto& kvp : proxies_) {
+        auto msg = make_message(group_down_msg{group{kvp.second.get()}});
+        kvp.second->send_all_subscribers(ctrl(), std::move(msg), context());
+      }
+      quit(dm.reason);
+    }
+  });
+  return {
+    [=](join_atom, const std::string& pattern, const group& grp) {
+      CAF_LOG_TRACE(CAF_ARG(pattern));
+      // only our proxies send join messages, hence the cast is safe
+      auto ptr = static_cast<topic_group_proxy*>(grp.get());
+      proxies_.emplace(pattern, ptr);
+      send(remote_broker_, join_atom::value, pattern, actor{this});
+    },
+    [=](leave_atom, const std::string& pattern) {
+      CAF_LOG_TRACE(CAF_ARG(pattern));
+      if (proxies_.erase(pattern) > 0)
+        send(remote_broker_, leave_atom::value, pattern, actor{this});
+    },
+    [=](forward_atom, const std::string& topic, const message& what) {
+      CAF_LOG_TRACE(CAF_ARG(topic) << CAF_ARG(what));
+      std::vector<strong_actor_ptr> receivers;
+      for (auto& kvp : proxies_)
+        if (detail::topic_trie::matches(kvp.first, topic))
+          kvp.second->append_subscribers(receivers);
+      // an actor subscribing to multiple matching patterns receives a
+      // message only once
+      std::sort(receivers.begin(), receivers.end(),
+                [](const strong_actor_ptr& x, const strong_actor_ptr& y) {
+                  return x.get() < y.get();
+                });
+      receivers.erase(std::unique(receivers.begin(), receivers.end()),
+                      receivers.end());
+      detail::multicast(current_element_->sender, receivers, what,
+                        context());
+    }
+  };
+}
+
+// Accepts subscriptions from remote proxies and publishes on their behalf.
+class topic_broker : public event_based_actor {
+public:
+  topic_broker(actor_config& cfg, topic_group_module& mod)
+      : event_based_actor(cfg),
+        module_(mod) {
+    // nop
+  }
+
+  const char* name() const override {
+    return "topic_broker";
+  }
+
+  behavior make_behavior() override;
+
+private:
+  topic_group_module& module_;
+  std::unordered_map<actor_addr, std::set<std::string>> remote_patterns_;
+};
+
+class topic_group_module : public group_module {
+public:
+  topic_group_module(actor_system& sys) : group_module(sys, "topic") {
+    CAF_LOG_TRACE("");
+  }
+
+  expected<group> get(const std::string& identifier) override {
+    CAF_LOG_TRACE(CAF_ARG(identifier));
+    if (!detail::topic_trie::valid_pattern(identifier))
+      return make_error(sec::invalid_argument, "invalid topic", identifier);
+    upgrade_guard guard(instances_mtx_);
+    auto i = instances_.find(identifier);
+    if (i != instances_.end())
+      return group{i->second};
+    auto tmp = make_counted<topic_group>(*this, identifier, system().node(),
+                                         broker());
+    upgrade_to_unique_guard uguard(guard);
+    auto p = instances_.emplace(identifier, tmp);
+    // someone might preempt us
+    return group{p.first->second};
+  }
+
+  // returns the local instance for `topic` if it exists, `nullptr` otherwise
+  topic_group_ptr find(const std::string& topic) {
+    shared_guard guard(instances_mtx_);
+    auto i = instances_.find(topic);
+    return i != instances_.end() ? i->second : nullptr;
+  }
+
+  error load(deserializer& source, group& storage) override {
+    CAF_LOG_TRACE("");
+    std::string identifier;
+    strong_actor_ptr broker_ptr;
+    auto e = source(identifier, broker_ptr);
+    if (e)
+      return e;
+    CAF_LOG_DEBUG(CAF_ARG(identifier) << CAF_ARG(broker_ptr));
+    if (!broker_ptr) {
+      storage = invalid_group;
+      return none;
+    }
+    auto broker = actor_cast<actor>(broker_ptr);
+    if (broker->node() == system().node()) {
+      auto res = get(identifier);
+      if (!res)
+        return std::move(res.error());
+      storage = std::move(*res);
+      return none;
+    }
+    auto key = std::make_pair(broker, identifier);
+    upgrade_guard guard(proxies_mtx_);
+    auto i = proxies_.find(key);
+    if (i != proxies_.end()) {
+      storage = group{i->second};
+      return none;
+    }
+    upgrade_to_unique_guard uguard(guard);
+    // all proxies for the same remote broker share a single proxy broker
+    auto& proxy_broker = proxy_brokers_[broker];
+    if (!proxy_broker)
+      proxy_broker = system().spawn<topic_proxy_broker, hidden>(broker);
+    topic_group_ptr tmp = make_counted<topic_group_proxy>(*this, identifier,
+                                                          broker,
+                                                          proxy_broker);
+    auto p = proxies_.emplace(std::move(key), tmp);
+    storage = group{p.first->second};
+    return none;
+  }
+
+  error save(const topic_group* ptr, serializer& sink) const {
+    CAF_ASSERT(ptr != nullptr);
+    CAF_LOG_TRACE("");
+    auto bro = actor_cast<strong_actor_ptr>(ptr->broker());
+    auto& id = const_cast<std::string&>(ptr->identifier());
+    return sink(id, bro);
+  }
+
+  void stop() override {
+    CAF_LOG_TRACE("");
+    std::map<std::string, topic_group_ptr> imap;
+    std::map<std::pair<actor, std::string>, topic_group_ptr> pmap;
+    std::map<actor, actor> bmap;
+    { // critical section
+      exclusive_guard guard1{instances_mtx_};
+      exclusive_guard guard2{proxies_mtx_};
+      imap.swap(instances_);
+      pmap.swap(proxies_);
+      bmap.swap(proxy_brokers_);
+    }
+    std::vector<actor> proxy_brokers;
+    for (auto& kvp : bmap)
+      proxy_brokers.push_back(kvp.second);
+    await_all_locals_down(system(), proxy_brokers);
+    actor bro;
+    { // critical section
+      std::unique_lock<std::mutex> guard{broker_mtx_};
+      bro.swap(broker_);
+    }
+    if (bro)
+      await_all_locals_down(system(), {bro});
+    { // critical section
+      exclusive_guard guard{trie_mtx_};
+      trie_.clear();
+      remote_trie_.clear();
+    }
+    // handles to the groups may outlive the module
+    for (auto& kvp : imap)
+      kvp.second->invalidate();
+  }
+
+  bool subscribe(const std::string& pattern, strong_actor_ptr who) {
+    CAF_LOG_TRACE(CAF_ARG(pattern) << CAF_ARG(who));
+    return add(trie_, pattern, std::move(who));
+  }
+
+  bool unsubscribe(const std::string& pattern, const actor_control_block* who) {
+    CAF_LOG_TRACE(CAF_ARG(pattern));
+    return erase(trie_, pattern, who);
+  }
+
+  // subscribes the proxy broker of a remote node
+  bool subscribe_remote(const std::string& pattern, strong_actor_ptr who) {
+    CAF_LOG_TRACE(CAF_ARG(pattern) << CAF_ARG(who));
+    return add(remote_trie_, pattern, std::move(who));
+  }
+
+  bool unsubscribe_remote(const std::string& pattern,
+                          const actor_control_block* who) {
+    CAF_LOG_TRACE(CAF_ARG(pattern));
+    return erase(remote_trie_, pattern, who);
+  }
+
+  // returns all receivers with a pattern matching `topic`
+  topic_match match(size_t version, const std::string& topic) {
+    std::vector<strong_actor_ptr> xs;
+    std::vector<strong_actor_ptr> ys;
+    { // critical section
+      shared_guard guard{trie_mtx_};
+      xs = trie_.match(topic);
+      ys = remote_trie_.match(topic);
+    }
+    return {version, detail::multicast_plan{xs}, detail::multicast_plan{ys}};
+  }
+
+private:
+  bool add(detail::topic_trie& trie, const std::string& pattern,
+           strong_actor_ptr who) {
+    exclusive_guard guard{trie_mtx_};
+    if (!trie.add(pattern, std::move(who)))
+      return false;
+    invalidate(pattern);
+    return true;
+  }
+
+  bool erase(detail::topic_trie& trie, const std::string& pattern,
+             const actor_control_block* who) {
+    exclusive_guard guard{trie_mtx_};
+    if (!trie.erase(pattern, who))
+      return false;
+    invalidate(pattern);
+    return true;
+  }
+
+  // invalidates the cached matches of all topics matching `pattern`,
+  // requires a lock on `trie_mtx_`
+  void invalidate(const std::string& pattern) {
+    shared_guard guard{instances_mtx_};
+    for (auto& kvp : instances_)
+      if (detail::topic_trie::matches(pattern, kvp.first))
+        kvp.second->invalidate();
+  }
+
+  // returns the topic broker of this node, spawning it on first use
+  actor broker() {
+    std::unique_lock<std::mutex> guard{broker_mtx_};
+    if (!broker_)
+      broker_ = system().spawn<topic_broker, hidden>(*this);
+    return broker_;
+  }
+
+  detail::shared_spinlock instances_mtx_;
+  std::map<std::string, topic_group_ptr> instances_;
+  detail::shared_spinlock proxies_mtx_;
+  std::map<std::pair<actor, std::string>, topic_group_ptr> proxies_;
+  std::map<actor, actor> proxy_brokers_;
+  detail::shared_spinlock trie_mtx_;
+  detail::topic_trie trie_;
+  detail::topic_trie remote_trie_;
+  std::mutex broker_mtx_;
+  actor broker_;
+};
+
+behavior topic_broker::make_behavior() {
+  CAF_LOG_TRACE("");
+  set_down_handler([=](down_msg& dm) {
+    CAF_LOG_TRACE(CAF_ARG(dm));
+    auto i = remote_patterns_.find(dm.source);
+    if (i == remote_patterns_.end())
+      return;
+    for (auto& pattern : i->second)
+      module_.unsubscribe_remote(pattern, dm.source.get());
+    remote_patterns_.erase(i);
+  });
+  return {
+    [=](join_atom, const std::string& pattern, const actor& proxy) {
+      CAF_LOG_TRACE(CAF_ARG(pattern) << CAF_ARG(proxy));
+      if (!proxy || !detail::topic_trie::valid_pattern(pattern))
+        return;
+      auto ptr = actor_cast<strong_actor_ptr>(proxy);
+      if (!module_.subscribe_remote(pattern, std::move(ptr)))
+        return;
+      auto& patterns = remote_patterns_[proxy.address()];
+      if (patterns.empty())
+        monitor(proxy);
+      patterns.insert(pattern);
+    },
+    [=](leave_atom, const std::string& pattern, const actor& proxy) {
+      CAF_LOG_TRACE(CAF_ARG(pattern) << CAF_ARG(proxy));
+      auto i = remote_patterns_.find(proxy.address());
+      if (i == remote_patterns_.end() || i->second.erase(pattern) == 0)
+        return;
+      module_.unsubscribe_remote(pattern,
+                                 actor_cast<strong_actor_ptr>(proxy).get());
+      if (i->second.empty()) {
+        demonitor(proxy);
+        remote_patterns_.erase(i);
+      }
+    },
+    [=](forward_atom, const std::string& topic, const message& what) {
+      CAF_LOG_TRACE(CAF_ARG(topic) << CAF_ARG(what));
+      // Remote publishers may use arbitrary topics. Hence, we only use
+      // existing instances instead of creating one per topic.
+      auto grp = module_.find(topic);
+      if (grp)
+        grp->enqueue(current_element_->sender, invalid_message_id, what,
+                     context());
+      else if (detail::topic_trie::valid_pattern(topic)
+               && !detail::topic_trie::is_pattern(topic))
+        publish(module_.match(0, topic), topic, current_element_->sender,
+                what, context());
+    }
+  };
+}
+
+topic_group::topic_group(topic_group_module& mod, std::string id, node_id nid,
+                         actor broker)
+    : abstract_group(mod, std::move(id), std::move(nid)),
+      broker_(std::move(broker)),
+      is_pattern_(detail::topic_trie::is_pattern(identifier_)),
+      version_(0) {
+  CAF_LOG_TRACE(CAF_ARG(identifier_));
+}
+
+topic_group::~topic_group() {
+  // nop
+}
+
+void topic_group::enqueue(strong_actor_ptr sender, message_id, message msg,
+                          execution_unit* host) {
+  CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(msg));
+  if (is_pattern_) {
+    CAF_LOG_WARNING("cannot publish to a topic pattern:" << CAF_ARG(identifier_));
+    return;
+  }
+  // read the version before computing the match in order to never store an
+  // outdated match with an up-to-date version
+  auto version = version_.load();
+  auto ptr = std::atomic_load(&cache_);
+  if (!ptr || ptr->version != version) {
+    ptr = std::make_shared<topic_match>(module().match(version, identifier_));
+    std::atomic_store(&cache_, ptr);
+  }
+  publish(*ptr, identifier_, sender, msg, host);
+}
+
+bool topic_group::subscribe(strong_actor_ptr who) {
+  CAF_LOG_TRACE(CAF_ARG(who));
+  if (!who)
+    return false;
+  return module().subscribe(identifier_, std::move(who));
+}
+
+void topic_group::unsubscribe(const actor_control_block* who) {
+  CAF_LOG_TRACE(CAF_ARG(who));
+  module().unsubscribe(identifier_, who);
+}
+
+error topic_group::save(serializer& sink) const {
+  CAF_LOG_TRACE("");
+  return module().save(this, sink);
+}
+
+topic_group_module& topic_group::module() const {
+  // this cast is safe, because the only available constructor accepts
+  // topic_group_module& as module
+  return static_cast<topic_group_module&>(parent_);
+}
+
+topic_group_proxy::topic_group_proxy(topic_group_module& mod, std::string id,
+                                     actor remote_broker, actor proxy_broker)
+    : topic_group(mod, std::move(id), remote_broker->node(), remote_broker),
+      proxy_broker_(std::move(proxy_broker)) {
+  // nop
+}
+
 std::atomic<size_t> s_ad_hoc_id;
 
 } // namespace <anonymous>
@@ -442,6 +1186,7 @@ void group_manager::init(actor_system_config& cfg) {
   CAF_LOG_TRACE("");
   using ptr_type = std::unique_ptr<group_module>;
   mmap_.emplace("local", ptr_type{new local_group_module(system_)});
+  mmap_.emplace("topic", ptr_type{new topic_group_module(system_)});
   for (auto& fac : cfg.group_module_factories) {
     ptr_type ptr{fac()};
     std::string name = ptr->name();
@@ -35,7 +35,9 @@ inbound_path::inbound_path(local_actor* selfptr, const stream_id& id,
       last_acked_batch_id(0),
       last_batch_id(0),
       assigned_credit(0),
-      redeployable(false) {
+      redeployable(false),
+      total_credit(0),
+      total_received(0) {
   // nop
 }
 
@@ -61,6 +63,8 @@ void inbound_path::emit_ack_open(actor_addr rebind_from,
                 << CAF_ARG(is_redeployable));
   assigned_credit = initial_demand;
   redeployable = is_redeployable;
+  if (controller && controller->measures())
+    record_grant(initial_demand, std::chrono::steady_clock::now());
   unsafe_send_as(self, hdl,
                  make<stream_msg::ack_open>(
                    sid, self->address(), std::move(rebind_from), self->ctrl(),
@@ -71,12 +75,34 @@ void inbound_path::emit_ack_batch(long new_demand) {
   CAF_LOG_TRACE(CAF_ARG(new_demand));
   last_acked_batch_id = last_batch_id;
   assigned_credit += new_demand;
+  if (controller && controller->measures())
+    record_grant(new_demand, std::chrono::steady_clock::now());
   unsafe_send_as(self, hdl,
                  make<stream_msg::ack_batch>(sid, self->address(),
                                              static_cast<int32_t>(new_demand),
                                              last_batch_id));
 }
 
+void inbound_path::record_grant(long amount, time_point t) {
+  total_credit += amount;
+  credit_grants.emplace_back(total_credit, t);
+}
+
+timespan inbound_path::batch_latency(long n, time_point t) {
+  total_received += n;
+  // drop grants that only covered previous batches
+  while (!credit_grants.empty()
+         && credit_grants.front().first < total_received)
+    credit_grants.pop_front();
+  if (credit_grants.empty())
+    return timespan{0};
+  auto result = std::chrono::duration_cast<timespan>(
+    t - credit_grants.front().second);
+  if (credit_grants.front().first == total_received)
+    credit_grants.pop_front();
+  return result;
+}
+
 void inbound_path::emit_irregular_shutdown(local_actor* self,
                                            const stream_id& sid,
                                            const strong_actor_ptr& hdl,
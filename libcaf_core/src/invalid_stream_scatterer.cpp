@@ -81,6 +81,10 @@ void invalid_stream_scatterer::emit_batches() {
   // nop
 }
 
+void invalid_stream_scatterer::force_emit_batches() {
+  // nop
+}
+
 stream_scatterer::path_type* invalid_stream_scatterer::find(const stream_id&,
                                                             const actor_addr&) {
   return nullptr;
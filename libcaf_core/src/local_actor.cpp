@@ -62,6 +62,14 @@ void local_actor::on_destroy() {
   }
 }
 
+size_t local_actor::mailbox_size_hint() const noexcept {
+  return mailbox_.size_hint();
+}
+
+void local_actor::track_mailbox_size() {
+  mailbox_.track_size();
+}
+
 void local_actor::request_response_timeout(const duration& d, message_id mid) {
   CAF_LOG_TRACE(CAF_ARG(d) << CAF_ARG(mid));
   if (!d.valid())
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/multicast.hpp"
+
+#include <utility>
+#include <algorithm>
+
+#include "caf/atom.hpp"
+#include "caf/logger.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/forwarding_actor_proxy.hpp"
+
+namespace caf {
+namespace detail {
+
+multicast_plan::multicast_plan(const std::vector<strong_actor_ptr>& receivers) {
+  // there's usually only a single manager, i.e., the BASP broker
+  for (auto& x : receivers) {
+    if (!x)
+      continue;
+    if (x->node() != x->home_system->node()) {
+      auto proxy = dynamic_cast<forwarding_actor_proxy*>(x->get());
+      if (proxy != nullptr) {
+        auto mgr = proxy->manager();
+        if (mgr) {
+          auto pred = [&](const bundle& y) {
+            return y.first == mgr;
+          };
+          auto i = std::find_if(bundles_.begin(), bundles_.end(), pred);
+          if (i == bundles_.end()) {
+            bundles_.emplace_back(std::move(mgr),
+                                  std::vector<strong_actor_ptr>{x});
+          } else {
+            i->second.push_back(x);
+          }
+          continue;
+        }
+      }
+    }
+    direct_.push_back(x);
+  }
+  // bundling a single receiver only adds overhead
+  auto single = [](const bundle& x) {
+    return x.second.size() == 1;
+  };
+  for (auto& b : bundles_)
+    if (single(b))
+      direct_.push_back(b.second.front());
+  bundles_.erase(std::remove_if(bundles_.begin(), bundles_.end(), single),
+                 bundles_.end());
+}
+
+void multicast_plan::send(const strong_actor_ptr& sender, const message& msg,
+                          execution_unit* host) const {
+  CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(direct_.size())
+                << CAF_ARG(bundles_.size()) << CAF_ARG(msg));
+  for (auto& x : direct_)
+    x->enqueue(sender, invalid_message_id, msg, host);
+  for (auto& b : bundles_)
+    b.first->enqueue(nullptr, invalid_message_id,
+                     make_message(multicast_atom::value, sender, b.second,
+                                  msg),
+                     host);
+}
+
+void multicast(const strong_actor_ptr& sender,
+               const std::vector<strong_actor_ptr>& receivers,
+               const message& msg, execution_unit* host) {
+  multicast_plan{receivers}.send(sender, msg, host);
+}
+
+} // namespace detail
+} // namespace caf
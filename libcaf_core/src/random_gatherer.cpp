@@ -30,17 +30,23 @@ random_gatherer::~random_gatherer() {
 }
 
 void random_gatherer::assign_credit(long available) {
-    CAF_LOG_TRACE(CAF_ARG(available));
-    for (auto& kvp : assignment_vec_) {
-      auto x = std::min(available, max_credit() - kvp.first->assigned_credit);
-      available -= x;
-      kvp.second = x;
-    }
-    emit_credits();
+  CAF_LOG_TRACE(CAF_ARG(available));
+  for (auto& kvp : assignment_vec_) {
+    auto& path = *kvp.first;
+    auto& ctrl = *path.controller;
+    auto x = std::min(available, ctrl.max_credit() - path.assigned_credit);
+    // Hand out credit in chunks of at least one batch unless the source ran
+    // out of credit, since it otherwise sends many small batches.
+    if (x <= 0 || (x < ctrl.batch_size() && path.assigned_credit > 0))
+      x = 0;
+    available -= x;
+    kvp.second = x;
+  }
+  emit_credits();
 }
 
-long random_gatherer::initial_credit(long available, path_type*) {
-  return std::min(available, max_credit());
+long random_gatherer::initial_credit(long available, path_type* x) {
+  return std::min(available, x->controller->max_credit());
 }
 
 /*
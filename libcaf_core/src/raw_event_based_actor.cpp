@@ -78,6 +78,11 @@ invoke_message_result raw_event_based_actor::consume(mailbox_element& x) {
     CAF_LOG_DEBUG("dropped expired timeout message");
     return im_dropped;
   }
+  if (is_stream_tick(x)) {
+    CAF_LOG_DEBUG("handle stream tick");
+    handle_stream_flush();
+    return im_success;
+  }
   // handle everything else as ordinary message
   detail::default_invoke_result_visitor<event_based_actor> visitor{this};
   bool skipped = false;
@@ -19,6 +19,9 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include <chrono>
+#include <algorithm>
+
 #include "caf/config.hpp"
 #include "caf/to_string.hpp"
 #include "caf/actor_ostream.hpp"
@@ -98,6 +101,7 @@ error scheduled_actor::default_exception_handler(pointer ptr,
 scheduled_actor::scheduled_actor(actor_config& cfg)
     : local_actor(cfg),
       timeout_id_(0),
+      stream_flush_deadline_(stream_manager::clock_type::time_point::max()),
       default_handler_(print_and_drop),
       error_handler_(default_error_handler),
       down_handler_(default_down_handler),
@@ -225,8 +229,12 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
     return resume_result::done;
   size_t handled_msgs = 0;
   auto reset_timeout_if_needed = [&] {
-    if (handled_msgs > 0 && !bhvr_stack_.empty())
-      request_timeout(bhvr_stack_.back().timeout());
+    if (handled_msgs > 0) {
+      if (!bhvr_stack_.empty())
+        request_timeout(bhvr_stack_.back().timeout());
+      if (!streams_.empty())
+        request_stream_flush();
+    }
   };
   mailbox_element_ptr ptr;
   while (handled_msgs < max_throughput) {
@@ -318,6 +326,49 @@ bool scheduled_actor::is_active_timeout(uint32_t tid) const {
   return getf(has_timeout_flag) && timeout_id_ == tid;
 }
 
+void scheduled_actor::request_stream_flush() {
+  using std::chrono::microseconds;
+  using std::chrono::duration_cast;
+  auto now = system().scheduler().now();
+  auto next = stream_manager::clock_type::time_point::max();
+  for (auto& kvp : streams_)
+    next = std::min(next, kvp.second->flush_deadline(now));
+  if (next >= stream_flush_deadline_)
+    return;
+  stream_flush_deadline_ = next;
+  // the tick is an internal message, only accepted from this actor
+  auto msg = make_message(sys_atom::value, stream_atom::value);
+  CAF_LOG_TRACE("send new stream tick");
+  if (next <= now) {
+    enqueue(ctrl(), invalid_message_id, std::move(msg), context());
+    return;
+  }
+  // round up to make sure the deadline has passed when receiving the tick
+  auto us = duration_cast<microseconds>(next - now) + microseconds(1);
+  system().scheduler().delayed_send(duration{us}, ctrl(),
+                                    strong_actor_ptr(ctrl()),
+                                    message_id::make(), std::move(msg));
+}
+
+void scheduled_actor::handle_stream_flush() {
+  CAF_LOG_TRACE("");
+  // the timer may fire slightly early, hence we always re-arm the tick
+  // afterwards for any deadline that is still pending
+  auto now = system().scheduler().now();
+  stream_flush_deadline_ = stream_manager::clock_type::time_point::max();
+  for (auto& kvp : streams_)
+    kvp.second->flush(now);
+  request_stream_flush();
+}
+
+bool scheduled_actor::is_stream_tick(const mailbox_element& x) {
+  auto& content = x.content();
+  return content.type_token() == make_type_token<atom_value, atom_value>()
+         && content.get_as<atom_value>(0) == sys_atom::value
+         && content.get_as<atom_value>(1) == stream_atom::value
+         && x.sender == ctrl();
+}
+
 // -- message processing -------------------------------------------------------
 
 void scheduled_actor::add_awaited_response_handler(message_id response_id,
@@ -365,6 +416,9 @@ scheduled_actor::categorize(mailbox_element& x) {
       return is_active_timeout(tid) ? message_category::timeout
                                     : message_category::expired_timeout;
     }
+    case make_type_token<atom_value, atom_value>():
+      return is_stream_tick(x) ? message_category::stream_tick
+                               : message_category::ordinary;
     case make_type_token<exit_msg>(): {
       auto em = content.move_if_unshared<exit_msg>(0);
       // make sure to get rid of attachables if they're no longer needed
@@ -461,6 +515,10 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
     case message_category::internal:
       CAF_LOG_DEBUG("handled system message");
       return im_success;
+    case message_category::stream_tick:
+      CAF_LOG_DEBUG("handle stream tick");
+      handle_stream_flush();
+      return im_success;
     case message_category::timeout: {
       CAF_LOG_DEBUG("handle timeout message");
       if (bhvr_stack_.empty())
@@ -19,6 +19,7 @@
 
 #include "caf/stream_gatherer.hpp"
 
+#include "caf/message.hpp"
 #include "caf/actor_addr.hpp"
 #include "caf/actor_cast.hpp"
 #include "caf/inbound_path.hpp"
@@ -30,6 +31,14 @@ stream_gatherer::~stream_gatherer() {
   // nop
 }
 
+message stream_gatherer::merge(path_ptr, message& xs) {
+  return std::move(xs);
+}
+
+message stream_gatherer::drain() {
+  return {};
+}
+
 bool stream_gatherer::remove_path(const stream_id& sid,
                                   const strong_actor_ptr& x, error reason,
                                   bool silent) {
@@ -19,6 +19,14 @@
 
 #include "caf/stream_gatherer_impl.hpp"
 
+#include "caf/atom.hpp"
+#include "caf/local_actor.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/actor_system_config.hpp"
+
+#include "caf/detail/fixed_credit_controller.hpp"
+#include "caf/detail/throughput_credit_controller.hpp"
+
 namespace caf {
 
 stream_gatherer_impl::stream_gatherer_impl(local_actor* selfptr)
@@ -53,6 +61,7 @@ stream_gatherer_impl::add_path(const stream_id& sid, strong_actor_ptr hdl,
   if (result_cb.pending())
     listeners_.emplace_back(std::move(result_cb));
   ptr->prio = prio;
+  ptr->controller = make_credit_controller();
   ptr->emit_ack_open(actor_cast<actor_addr>(original_stage),
                      initial_credit(available_credit, ptr), redeployable);
   return ptr;
@@ -121,6 +130,23 @@ void stream_gatherer_impl::max_credit(long x) {
   max_credit_ = x;
 }
 
+std::unique_ptr<credit_controller>
+stream_gatherer_impl::make_credit_controller() {
+  std::unique_ptr<credit_controller> result;
+  auto& cfg = self_->system().config();
+  if (cfg.stream_credit_policy == atom("throughput")) {
+    using std::chrono::microseconds;
+    auto credit_budget = microseconds(cfg.stream_credit_time_budget_us);
+    auto batch_budget = microseconds(cfg.stream_batch_time_budget_us);
+    result.reset(new detail::throughput_credit_controller(
+      credit_budget, batch_budget, max_credit_, min_credit_assignment_,
+      static_cast<long>(cfg.stream_max_credit)));
+  } else {
+    result.reset(new detail::fixed_credit_controller(this));
+  }
+  return result;
+}
+
 void stream_gatherer_impl::emit_credits() {
   for (auto& kvp : assignment_vec_)
     if (kvp.second > 0)
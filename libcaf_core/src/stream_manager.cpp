@@ -19,9 +19,12 @@
 
 #include "caf/stream_manager.hpp"
 
+#include <chrono>
+
 #include "caf/sec.hpp"
 #include "caf/error.hpp"
 #include "caf/logger.hpp"
+#include "caf/duration.hpp"
 #include "caf/message.hpp"
 #include "caf/expected.hpp"
 #include "caf/actor_addr.hpp"
@@ -34,6 +37,12 @@
 
 namespace caf {
 
+stream_manager::stream_manager()
+    : self_(nullptr),
+      flush_deadline_(clock_type::time_point::max()) {
+  // nop
+}
+
 stream_manager::~stream_manager() {
   // nop
 }
@@ -91,7 +100,21 @@ error stream_manager::batch(const stream_id& sid, const actor_addr& hdl,
     return sec::invalid_stream_state;
   }
   ptr->handle_batch(xs_size, xs_id);
-  auto err = process_batch(xs);
+  using clock_type = std::chrono::steady_clock;
+  // Taking timestamps is only worth it if the controller uses them.
+  auto measure = ptr->controller && ptr->controller->measures();
+  clock_type::time_point t0;
+  if (measure)
+    t0 = clock_type::now();
+  // The gatherer may hold back some or all elements, e.g., for merging.
+  auto ys = in().merge(ptr, xs);
+  auto err = ys.empty() ? none : process_batch(ys);
+  if (measure) {
+    auto t1 = clock_type::now();
+    ptr->controller->batch_processed(
+      xs_size, std::chrono::duration_cast<timespan>(t1 - t0),
+      ptr->batch_latency(xs_size, t0));
+  }
   if (err == none) {
     push();
     auto current_size = out().buffered();
@@ -115,8 +138,18 @@ error stream_manager::ack_batch(const stream_id& sid, const actor_addr& hdl,
 
 error stream_manager::close(const stream_id& sid, const actor_addr& hdl) {
   CAF_LOG_TRACE(CAF_ARG(sid) << CAF_ARG(hdl));
-  if (in().remove_path(sid, hdl, none, true) && in().closed())
-    input_closed(none);
+  if (in().remove_path(sid, hdl, none, true)) {
+    // Held back elements may no longer wait for the removed path.
+    auto ys = in().drain();
+    if (!ys.empty()) {
+      auto err = process_batch(ys);
+      if (err)
+        return err;
+      push();
+    }
+    if (in().closed())
+      input_closed(none);
+  }
   return none;
 }
 
@@ -189,6 +222,26 @@ void stream_manager::push() {
   out().emit_batches();
 }
 
+stream_manager::clock_type::time_point
+stream_manager::flush_deadline(clock_type::time_point now) {
+  auto& o = out();
+  if (o.buffered() == 0 || !o.max_batch_delay().valid()) {
+    flush_deadline_ = clock_type::time_point::max();
+  } else if (flush_deadline_ == clock_type::time_point::max()) {
+    flush_deadline_ = now;
+    flush_deadline_ += o.max_batch_delay();
+  }
+  return flush_deadline_;
+}
+
+void stream_manager::flush(clock_type::time_point now) {
+  if (now < flush_deadline_)
+    return;
+  CAF_LOG_TRACE("");
+  flush_deadline_ = clock_type::time_point::max();
+  out().force_emit_batches();
+}
+
 bool stream_manager::generate_messages() {
   return false;
 }
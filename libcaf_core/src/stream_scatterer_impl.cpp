@@ -19,6 +19,9 @@
 
 #include "caf/stream_scatterer_impl.hpp"
 
+#include <limits>
+#include <algorithm>
+
 #include "caf/logger.hpp"
 #include "caf/outbound_path.hpp"
 
@@ -109,6 +112,17 @@ long stream_scatterer_impl::max_credit() const {
   return max_credit(paths_);
 }
 
+long stream_scatterer_impl::batch_threshold(bool force) const {
+  if (force || !max_batch_delay().valid())
+    return 1;
+  return std::max(min_batch_size(), 1l);
+}
+
+long stream_scatterer_impl::batch_limit() const {
+  auto x = max_batch_size();
+  return x > 0 ? x : std::numeric_limits<long>::max();
+}
+
 long stream_scatterer_impl::min_batch_size() const {
   return min_batch_size_;
 }
@@ -86,6 +86,10 @@ void terminal_stream_scatterer::emit_batches() {
   // nop
 }
 
+void terminal_stream_scatterer::force_emit_batches() {
+  // nop
+}
+
 stream_scatterer::path_type*
 terminal_stream_scatterer::find(const stream_id&, const actor_addr&) {
   return nullptr;
@@ -71,7 +71,7 @@ public:
     mh_.assign(
       [&](const duration& d, strong_actor_ptr& from,
           strong_actor_ptr& to, message_id mid, message& msg) {
-        auto tout = test_coordinator::hrc::now();
+        auto tout = parent_->now();
         tout += d;
         using delayed_msg = test_coordinator::delayed_msg;
         parent_->delayed_messages.emplace(tout, delayed_msg{std::move(from),
@@ -92,7 +92,9 @@ private:
 
 } // namespace <anonymous>
 
-test_coordinator::test_coordinator(actor_system& sys) : super(sys) {
+test_coordinator::test_coordinator(actor_system& sys)
+    : super(sys),
+      current_time_(clock_type::now()) {
   // nop
 }
 
@@ -175,6 +177,8 @@ bool test_coordinator::dispatch_once() {
   auto i = delayed_messages.begin();
   if (i == delayed_messages.end())
     return false;
+  if (current_time_ < i->first)
+    current_time_ = i->first;
   auto& dm = i->second;
   dm.to->enqueue(dm.from, dm.mid, std::move(dm.msg), nullptr);
   delayed_messages.erase(i);
@@ -209,6 +213,26 @@ void test_coordinator::inline_all_enqueues() {
   after_next_enqueue([=] { inline_all_enqueues_helper(); });
 }
 
+bool test_coordinator::trigger_timeout() {
+  if (delayed_messages.empty())
+    return false;
+  auto t = delayed_messages.begin()->first;
+  while (!delayed_messages.empty() && delayed_messages.begin()->first <= t)
+    dispatch_once();
+  return true;
+}
+
+size_t test_coordinator::trigger_timeouts() {
+  auto result = delayed_messages.size();
+  while (trigger_timeout())
+    ; // repeat
+  return result;
+}
+
+test_coordinator::clock_type::time_point test_coordinator::now() const {
+  return current_time_;
+}
+
 void test_coordinator::inline_all_enqueues_helper() {
   run_once_lifo();
   after_next_enqueue([=] { inline_all_enqueues_helper(); });
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/throughput_credit_controller.hpp"
+
+#include <algorithm>
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// Weight of a new sample in the moving averages.
+constexpr double sample_weight = 0.25;
+
+// Lower bound for the processing time per element in nanoseconds, prevents
+// divisions by zero for batches that took less than the clock resolution.
+constexpr double min_ns_per_element = 1.;
+
+double moving_average(double avg, double sample) {
+  return avg + sample_weight * (sample - avg);
+}
+
+} // namespace <anonymous>
+
+throughput_credit_controller::throughput_credit_controller(
+  timespan credit_budget, timespan batch_budget, long initial_credit,
+  long min_credit, long max_credit)
+    : credit_budget_ns_(static_cast<double>(credit_budget.count())),
+      batch_budget_ns_(static_cast<double>(batch_budget.count())),
+      min_credit_(std::max(min_credit, 1l)),
+      max_credit_(std::max(max_credit, min_credit_)),
+      ns_per_element_(0.),
+      latency_ns_(0.) {
+  credit_ = std::min(std::max(initial_credit, min_credit_), max_credit_);
+  batch_size_ = min_credit_;
+}
+
+throughput_credit_controller::~throughput_credit_controller() {
+  // nop
+}
+
+void throughput_credit_controller::batch_processed(long num_elements,
+                                                   timespan processing_time,
+                                                   timespan latency) {
+  if (num_elements <= 0)
+    return;
+  auto t = std::max(static_cast<double>(processing_time.count())
+                    / static_cast<double>(num_elements),
+                    min_ns_per_element);
+  auto l = static_cast<double>(std::max(latency.count(), int64_t{0}));
+  if (ns_per_element_ == 0.) {
+    ns_per_element_ = t;
+    latency_ns_ = l;
+  } else {
+    ns_per_element_ = moving_average(ns_per_element_, t);
+    latency_ns_ = moving_average(latency_ns_, l);
+  }
+  credit_ = clamp((credit_budget_ns_ + latency_ns_) / ns_per_element_);
+  batch_size_ = std::min(clamp(batch_budget_ns_ / ns_per_element_), credit_);
+}
+
+long throughput_credit_controller::max_credit() const {
+  return credit_;
+}
+
+long throughput_credit_controller::batch_size() const {
+  return batch_size_;
+}
+
+long throughput_credit_controller::clamp(double x) const {
+  if (x >= static_cast<double>(max_credit_))
+    return max_credit_;
+  return std::max(static_cast<long>(x), min_credit_);
+}
+
+} // namespace detail
+} // namespace caf
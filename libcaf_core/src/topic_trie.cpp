@@ -0,0 +1,176 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/topic_trie.hpp"
+
+#include <algorithm>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+bool less_by_ptr(const strong_actor_ptr& x, const actor_control_block* y) {
+  return x.get() < y;
+}
+
+} // namespace <anonymous>
+
+bool topic_trie::valid_pattern(const std::string& x) {
+  if (x.empty())
+    return false;
+  auto levels = split(x);
+  for (size_t i = 0; i < levels.size(); ++i) {
+    auto& level = levels[i];
+    if (level.empty())
+      return false;
+    if (level == "**" && i + 1 != levels.size())
+      return false;
+  }
+  return true;
+}
+
+bool topic_trie::is_pattern(const std::string& x) {
+  auto levels = split(x);
+  return std::any_of(levels.begin(), levels.end(), [](const std::string& y) {
+    return y == "*" || y == "**";
+  });
+}
+
+bool topic_trie::matches(const std::string& pattern,
+                         const std::string& topic) {
+  auto xs = split(pattern);
+  auto ys = split(topic);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    // a trailing `**` matches any number of levels, including none
+    if (xs[i] == "**")
+      return true;
+    if (i == ys.size() || (xs[i] != "*" && xs[i] != ys[i]))
+      return false;
+  }
+  return xs.size() == ys.size();
+}
+
+bool topic_trie::add(const std::string& pattern, strong_actor_ptr who) {
+  CAF_ASSERT(who != nullptr);
+  auto x = &root_;
+  for (auto& level : split(pattern)) {
+    auto& child = x->children[level];
+    if (!child)
+      child.reset(new node);
+    x = child.get();
+  }
+  auto& xs = x->subscribers;
+  auto ptr = who.get();
+  auto i = std::lower_bound(xs.begin(), xs.end(), ptr, less_by_ptr);
+  if (i != xs.end() && i->get() == ptr)
+    return false;
+  xs.insert(i, std::move(who));
+  ++size_;
+  return true;
+}
+
+bool topic_trie::erase(const std::string& pattern,
+                       const actor_control_block* who) {
+  // remember the path for pruning empty nodes afterwards
+  auto levels = split(pattern);
+  std::vector<node*> path{&root_};
+  for (auto& level : levels) {
+    auto& children = path.back()->children;
+    auto i = children.find(level);
+    if (i == children.end())
+      return false;
+    path.push_back(i->second.get());
+  }
+  auto& xs = path.back()->subscribers;
+  auto i = std::lower_bound(xs.begin(), xs.end(), who, less_by_ptr);
+  if (i == xs.end() || i->get() != who)
+    return false;
+  xs.erase(i);
+  --size_;
+  for (auto n = levels.size(); n > 0; --n) {
+    auto x = path[n];
+    if (!x->subscribers.empty() || !x->children.empty())
+      break;
+    path[n - 1]->children.erase(levels[n - 1]);
+  }
+  return true;
+}
+
+topic_trie::subscriber_vec topic_trie::match(const std::string& topic) const {
+  subscriber_vec result;
+  collect(root_, split(topic), 0, result);
+  // an actor subscribing to multiple matching patterns receives a message
+  // only once
+  std::sort(result.begin(), result.end(),
+            [](const strong_actor_ptr& x, const strong_actor_ptr& y) {
+              return x.get() < y.get();
+            });
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+void topic_trie::clear() {
+  root_.children.clear();
+  root_.subscribers.clear();
+  size_ = 0;
+}
+
+topic_trie::level_vec topic_trie::split(const std::string& x) {
+  level_vec result;
+  std::string::size_type first = 0;
+  for (;;) {
+    auto last = x.find('/', first);
+    if (last == std::string::npos) {
+      result.emplace_back(x, first);
+      return result;
+    }
+    result.emplace_back(x, first, last - first);
+    first = last + 1;
+  }
+}
+
+void topic_trie::collect(const node& x, const level_vec& levels, size_t pos,
+                         subscriber_vec& result) {
+  auto append = [&](const node& y) {
+    result.insert(result.end(), y.subscribers.begin(), y.subscribers.end());
+  };
+  auto& children = x.children;
+  // a trailing `**` matches any number of levels, including none
+  auto i = children.find("**");
+  if (i != children.end())
+    append(*i->second);
+  if (pos == levels.size()) {
+    append(x);
+    return;
+  }
+  i = children.find(levels[pos]);
+  if (i != children.end())
+    collect(*i->second, levels, pos + 1, result);
+  if (levels[pos] != "*") {
+    i = children.find("*");
+    if (i != children.end())
+      collect(*i->second, levels, pos + 1, result);
+  }
+}
+
+} // namespace detail
+} // namespace caf
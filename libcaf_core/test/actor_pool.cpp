@@ -76,6 +76,33 @@ struct fixture {
     system.~actor_system();
     CAF_CHECK_EQUAL(s_dtors.load(), s_ctors.load());
   }
+
+  // Checks whether `pol` skips a worker with a full mailbox. The backed-up
+  // worker is a scoped actor that never reads its mailbox.
+  template <class Policy>
+  void check_skips_backed_up_worker(Policy pol) {
+    scoped_actor self{system};
+    scoped_actor busy{system};
+    auto pool = actor_pool::make(&context, std::move(pol));
+    self->send(pool, sys_atom::value, put_atom::value,
+               actor_cast<actor>(busy));
+    self->send(pool, sys_atom::value, put_atom::value, spawn_worker());
+    for (int i = 0; i < 10; ++i)
+      self->send(busy, i);
+    CAF_REQUIRE_EQUAL(busy->mailbox_size_hint(), 10u);
+    for (int i = 0; i < 20; ++i) {
+      self->request(pool, infinite, i, i).receive(
+        [&](int res) {
+          CAF_CHECK_EQUAL(res, i + i);
+        },
+        [&](error& err) {
+          CAF_FAIL("error: " << system.render(err));
+        }
+      );
+    }
+    CAF_CHECK_EQUAL(busy->mailbox().count(), 10u);
+    self->send_exit(pool, exit_reason::user_shutdown);
+  }
 };
 
 void handle_err(const error& err) {
@@ -183,6 +210,138 @@ CAF_TEST(random_actor_pool) {
   self->send_exit(pool, exit_reason::user_shutdown);
 }
 
+CAF_TEST(least_loaded_actor_pool) {
+  scoped_actor self{system};
+  auto pool = actor_pool::make(&context, 5, spawn_worker,
+                               actor_pool::least_loaded());
+  for (int i = 0; i < 5; ++i) {
+    self->request(pool, infinite, i, i).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, i + i);
+      },
+      handle_err
+    );
+  }
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(least_loaded_skips_backed_up_worker) {
+  check_skips_backed_up_worker(actor_pool::least_loaded());
+}
+
+CAF_TEST(key_hash_actor_pool) {
+  scoped_actor self{system};
+  auto key = [](const type_erased_tuple& x) {
+    return x.get_as<int>(0);
+  };
+  auto pool = actor_pool::make(&context, 5, spawn_worker,
+                               actor_pool::key_hash(key));
+  auto sender_of = [&](int x) {
+    actor result;
+    self->request(pool, infinite, x, 1).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, x + 1);
+        auto sender = actor_cast<strong_actor_ptr>(self->current_sender());
+        result = actor_cast<actor>(std::move(sender));
+      },
+      handle_err
+    );
+    return result;
+  };
+  for (int i = 0; i < 10; ++i)
+    CAF_CHECK_EQUAL(sender_of(i), sender_of(i));
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(power_of_two_actor_pool) {
+  scoped_actor self{system};
+  auto pool = actor_pool::make(&context, 5, spawn_worker,
+                               actor_pool::power_of_two());
+  for (int i = 0; i < 5; ++i) {
+    self->request(pool, infinite, i, i).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, i + i);
+      },
+      handle_err
+    );
+  }
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(power_of_two_skips_backed_up_worker) {
+  check_skips_backed_up_worker(actor_pool::power_of_two());
+}
+
+CAF_TEST(key_hash_distribution) {
+  // keys spread evenly over all buckets
+  constexpr size_t num_keys = 10000;
+  constexpr size_t num_buckets = 10;
+  std::vector<size_t> before;
+  std::vector<size_t> counts(num_buckets);
+  for (uint64_t key = 0; key < num_keys; ++key) {
+    auto bucket = detail::jump_consistent_hash(detail::mix64(key),
+                                               num_buckets);
+    CAF_REQUIRE_LESS(bucket, num_buckets);
+    before.push_back(bucket);
+    ++counts[bucket];
+  }
+  for (auto count : counts) {
+    CAF_CHECK_GREATER(count, 800u);
+    CAF_CHECK_LESS(count, 1200u);
+  }
+  // adding a bucket only moves keys to the new bucket, roughly 1 / 11
+  size_t moved = 0;
+  for (uint64_t key = 0; key < num_keys; ++key) {
+    auto bucket = detail::jump_consistent_hash(detail::mix64(key),
+                                               num_buckets + 1);
+    if (bucket != before[key]) {
+      CAF_CHECK_EQUAL(bucket, num_buckets);
+      ++moved;
+    }
+  }
+  CAF_CHECK_GREATER(moved, 700u);
+  CAF_CHECK_LESS(moved, 1100u);
+}
+
+CAF_TEST(consistent_hash_actor_pool) {
+  scoped_actor self{system};
+  auto key = [](const type_erased_tuple& x) {
+    return x.get_as<int>(0);
+  };
+  auto pool = actor_pool::make(&context, 4, spawn_worker,
+                               actor_pool::consistent_hash(key));
+  auto sender_of = [&](int x) {
+    actor result;
+    self->request(pool, infinite, x, 1).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, x + 1);
+        auto sender = actor_cast<strong_actor_ptr>(self->current_sender());
+        result = actor_cast<actor>(std::move(sender));
+      },
+      handle_err
+    );
+    return result;
+  };
+  std::vector<actor> before;
+  for (int i = 0; i < 100; ++i)
+    before.push_back(sender_of(i));
+  for (int i = 0; i < 100; ++i)
+    CAF_CHECK_EQUAL(sender_of(i), before[static_cast<size_t>(i)]);
+  // adding a worker may only move keys to the new worker
+  auto new_worker = spawn_worker();
+  self->send(pool, sys_atom::value, put_atom::value, new_worker);
+  size_t moved = 0;
+  for (int i = 0; i < 100; ++i) {
+    auto x = sender_of(i);
+    if (x != before[static_cast<size_t>(i)]) {
+      CAF_CHECK_EQUAL(x, new_worker);
+      ++moved;
+    }
+  }
+  CAF_CHECK_LESS(moved, 50u);
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
 CAF_TEST(split_join_actor_pool) {
   auto spawn_split_worker = [&] {
     return system.spawn<lazy_init>([]() -> behavior {
@@ -0,0 +1,187 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include <deque>
+#include <string>
+
+#define CAF_SUITE credit_controller
+#include "caf/test/dsl.hpp"
+
+#include "caf/detail/fixed_credit_controller.hpp"
+#include "caf/detail/throughput_credit_controller.hpp"
+
+using namespace caf;
+
+using detail::throughput_credit_controller;
+
+namespace {
+
+using std::chrono::milliseconds;
+
+timespan ms(int64_t x) {
+  return std::chrono::duration_cast<timespan>(milliseconds(x));
+}
+
+struct config : actor_system_config {
+  config() {
+    stream_credit_policy = atom("throughput");
+  }
+};
+
+behavior int_source(event_based_actor* self) {
+  using buf = std::deque<int>;
+  return {
+    [=](int n) -> stream<int> {
+      return self->make_source(
+        std::make_tuple(),
+        [=](buf& xs) {
+          for (int i = 1; i <= n; ++i)
+            xs.push_back(i);
+        },
+        [](buf& xs, downstream<int>& out, size_t num) {
+          auto n = std::min(num, xs.size());
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        [](const buf& xs) {
+          return xs.empty();
+        }
+      );
+    }
+  };
+}
+
+behavior int_sink(event_based_actor* self) {
+  return {
+    [=](stream<int>& in) {
+      return self->make_sink(
+        in,
+        [](int& x) {
+          x = 0;
+        },
+        [](int& x, int y) {
+          x += y;
+        },
+        [](int& x) -> int {
+          return x;
+        }
+      );
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(initial_credit) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 1, 10000};
+  CAF_CHECK_EQUAL(ctrl.max_credit(), 50);
+  CAF_CHECK_EQUAL(ctrl.batch_size(), 1);
+  throughput_credit_controller clamped{ms(10), ms(1), 50, 1, 20};
+  CAF_CHECK_EQUAL(clamped.max_credit(), 20);
+}
+
+CAF_TEST(credit_follows_processing_time) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 1, 100000};
+  CAF_MESSAGE("fast sink: 1us per element");
+  ctrl.batch_processed(1000, ms(1), timespan{0});
+  CAF_CHECK_EQUAL(ctrl.ns_per_element(), 1000.);
+  CAF_CHECK_EQUAL(ctrl.max_credit(), 10000);
+  CAF_CHECK_EQUAL(ctrl.batch_size(), 1000);
+  CAF_MESSAGE("slow sink: 1ms per element");
+  throughput_credit_controller slow{ms(10), ms(1), 50, 1, 100000};
+  slow.batch_processed(10, ms(10), timespan{0});
+  CAF_CHECK_EQUAL(slow.max_credit(), 10);
+  CAF_CHECK_EQUAL(slow.batch_size(), 1);
+}
+
+CAF_TEST(credit_covers_latency) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 1, 100000};
+  ctrl.batch_processed(1000, ms(1), ms(2));
+  CAF_CHECK_EQUAL(ctrl.latency_ns(), 2000000.);
+  CAF_CHECK_EQUAL(ctrl.max_credit(), 12000);
+  CAF_CHECK_EQUAL(ctrl.batch_size(), 1000);
+}
+
+CAF_TEST(moving_average) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 1, 100000};
+  ctrl.batch_processed(1000, ms(1), timespan{0});
+  ctrl.batch_processed(1000, ms(5), timespan{0});
+  // 1000ns + 0.25 * (5000ns - 1000ns)
+  CAF_CHECK_EQUAL(ctrl.ns_per_element(), 2000.);
+  CAF_CHECK_EQUAL(ctrl.max_credit(), 5000);
+  CAF_CHECK_EQUAL(ctrl.batch_size(), 500);
+  CAF_MESSAGE("empty batches leave the statistics unchanged");
+  ctrl.batch_processed(0, ms(100), ms(100));
+  CAF_CHECK_EQUAL(ctrl.ns_per_element(), 2000.);
+}
+
+CAF_TEST(bounds) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 10, 100};
+  ctrl.batch_processed(1000, timespan{0}, timespan{0});
+  CAF_CHECK_EQUAL(ctrl.max_credit(), 100);
+  CAF_CHECK_EQUAL(ctrl.batch_size(), 100);
+  throughput_credit_controller slow{ms(10), ms(1), 50, 10, 100};
+  slow.batch_processed(1, ms(100), timespan{0});
+  CAF_CHECK_EQUAL(slow.max_credit(), 10);
+  CAF_CHECK_EQUAL(slow.batch_size(), 10);
+}
+
+CAF_TEST(latency_per_grant) {
+  using std::chrono::milliseconds;
+  inbound_path path{nullptr, stream_id{}, nullptr};
+  inbound_path::time_point t0;
+  path.record_grant(10, t0);
+  path.record_grant(10, t0 + milliseconds(5));
+  CAF_MESSAGE("the first batch consumes the first grant");
+  CAF_CHECK_EQUAL(path.batch_latency(10, t0 + milliseconds(7)), ms(7));
+  CAF_MESSAGE("later batches refer to the second grant");
+  CAF_CHECK_EQUAL(path.batch_latency(5, t0 + milliseconds(8)), ms(3));
+  CAF_CHECK_EQUAL(path.batch_latency(5, t0 + milliseconds(9)), ms(4));
+  CAF_CHECK(path.credit_grants.empty());
+  CAF_MESSAGE("batches spanning several grants refer to the last one");
+  path.record_grant(10, t0 + milliseconds(10));
+  path.record_grant(10, t0 + milliseconds(12));
+  CAF_CHECK_EQUAL(path.batch_latency(15, t0 + milliseconds(14)), ms(2));
+  CAF_CHECK_EQUAL(path.credit_grants.size(), 1u);
+}
+
+CAF_TEST(fixed_controller_skips_measurements) {
+  throughput_credit_controller ctrl{ms(10), ms(1), 50, 1, 100000};
+  CAF_CHECK(ctrl.measures());
+  detail::fixed_credit_controller fixed{nullptr};
+  CAF_CHECK(!fixed.measures());
+}
+
+CAF_TEST_FIXTURE_SCOPE(throughput_streaming_tests,
+                       test_coordinator_fixture<config>)
+
+CAF_TEST(throughput_credit_policy) {
+  auto source = sys.spawn(int_source);
+  auto sink = sys.spawn(int_sink);
+  auto pipeline = sink * source;
+  sched.run();
+  self->send(pipeline, 1000);
+  sched.run();
+  CAF_CHECK_EQUAL(fetch_result(), 500500);
+  CAF_CHECK(deref(source).streams().empty());
+  CAF_CHECK(deref(sink).streams().empty());
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,77 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE fused_stage
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+#include <vector>
+
+#include "caf/unit.hpp"
+#include "caf/fused_stage.hpp"
+
+using namespace caf;
+
+CAF_TEST(composed_steps) {
+  auto f = fuse(
+    // drop even numbers
+    [](unit_t&, downstream<int>& out, int x) {
+      if (x % 2 != 0)
+        out.push(x);
+    },
+    // emit each number twice as string
+    [](unit_t&, downstream<std::string>& out, int x) {
+      out.push(std::to_string(x));
+      out.push(std::to_string(x));
+    },
+    // count characters seen so far
+    [](size_t& n, downstream<size_t>& out, std::string x) {
+      n += x.size();
+      out.push(n);
+    });
+  using fused_type = decltype(f);
+  static_assert(std::is_same<fused_type::input, int>::value,
+                "input of the fused stage must be the input of the first step");
+  static_assert(std::is_same<fused_type::output, size_t>::value,
+                "output of the fused stage must be the output of the last step");
+  fused_type::state st;
+  downstream<size_t>::queue_type buf;
+  downstream<size_t> out{buf};
+  for (int x : {1, 2, 9, 10, 11})
+    f(st, out, x);
+  CAF_CHECK_EQUAL(std::get<2>(st), 8u);
+  CAF_CHECK_EQUAL(std::vector<size_t>(buf.begin(), buf.end()),
+                  std::vector<size_t>({1, 2, 3, 4, 6, 8}));
+}
+
+CAF_TEST(single_step) {
+  auto f = fuse([](int& sum, downstream<int>& out, int x) {
+    sum += x;
+    out.push(sum);
+  });
+  decltype(f)::state st;
+  downstream<int>::queue_type buf;
+  downstream<int> out{buf};
+  for (int x : {1, 2, 3})
+    f(st, out, x);
+  CAF_CHECK_EQUAL(std::vector<int>(buf.begin(), buf.end()),
+                  std::vector<int>({1, 3, 6}));
+}
@@ -23,11 +23,15 @@
 #include "caf/test/unit_test.hpp"
 
 #include <array>
+#include <memory>
+#include <vector>
 #include <chrono>
 #include <algorithm>
 
 #include "caf/all.hpp"
 
+#include "caf/test/dsl.hpp"
+
 using namespace caf;
 
 namespace {
@@ -60,6 +64,32 @@ struct fixture {
   scoped_actor self{system};
 };
 
+struct collector_state {
+  std::vector<int> xs;
+};
+
+behavior collector_impl(stateful_actor<collector_state>* self) {
+  return {
+    [=](put_atom, int x) {
+      self->state.xs.push_back(x);
+    }
+  };
+}
+
+struct fan_out_config : actor_system_config {
+  fan_out_config() {
+    local_groups_fan_out_threshold = 2;
+  }
+};
+
+struct fan_out_fixture : test_coordinator_fixture<fan_out_config> {
+  ~fan_out_fixture() {
+    // the group module blocks on its helpers while shutting down
+    sched.run();
+    sched.inline_all_enqueues();
+  }
+};
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(group_tests, fixture)
@@ -87,5 +117,61 @@ CAF_TEST(class_based_joined_at_spawn) {
     self->send_exit(x, exit_reason::user_shutdown);
 }
 
+CAF_TEST(parallel_fan_out) {
+  actor_system_config cfg;
+  cfg.local_groups_fan_out_threshold = 4;
+  actor_system sys{cfg};
+  auto grp = sys.groups().get_local("fan-out");
+  std::vector<std::unique_ptr<scoped_actor>> subscribers;
+  for (int i = 0; i < 10; ++i) {
+    subscribers.emplace_back(new scoped_actor{sys});
+    (*subscribers.back())->join(grp);
+  }
+  scoped_actor publisher{sys};
+  for (int i = 0; i < 3; ++i)
+    publisher->send(grp, put_atom::value, i);
+  // each subscriber receives all messages in order
+  for (auto& s : subscribers) {
+    for (int i = 0; i < 3; ++i) {
+      (*s)->receive(
+        [&](put_atom, int x) {
+          CAF_CHECK_EQUAL(x, i);
+        },
+        after(std::chrono::seconds(5)) >> [&] {
+          CAF_FAIL("subscriber timed out");
+        }
+      );
+    }
+    (*s)->leave(grp);
+  }
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST_FIXTURE_SCOPE(fan_out_tests, fan_out_fixture)
+
+CAF_TEST(ordering_across_fan_out_threshold) {
+  auto grp = sys.groups().get_local("ordering");
+  auto subscriber = sys.spawn(collector_impl);
+  auto other = sys.spawn(collector_impl);
+  sched.run();
+  grp.subscribe(actor_cast<strong_actor_ptr>(subscriber));
+  // below the threshold
+  self->send(grp, put_atom::value, 1);
+  // at the threshold, spawns the helpers
+  grp.subscribe(actor_cast<strong_actor_ptr>(other));
+  self->send(grp, put_atom::value, 2);
+  // below the threshold again, must not overtake the previous message
+  grp.unsubscribe(actor_cast<actor_control_block*>(other));
+  self->send(grp, put_atom::value, 3);
+  sched.run();
+  using state_type = stateful_actor<collector_state>;
+  CAF_CHECK_EQUAL(deref<state_type>(subscriber).state.xs,
+                  std::vector<int>({1, 2, 3}));
+  grp.unsubscribe(actor_cast<actor_control_block*>(subscriber));
+  anon_send_exit(subscriber, exit_reason::user_shutdown);
+  anon_send_exit(other, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
@@ -30,6 +30,7 @@
 #include "caf/test/dsl.hpp"
 
 #include "caf/random_topic_scatterer.hpp"
+#include "caf/broadcast_topic_scatterer.hpp"
 
 #include "caf/detail/pull5_gatherer.hpp"
 #include "caf/detail/push5_scatterer.hpp"
@@ -77,20 +78,28 @@ struct selected_t {
   }
 };
 
+template <class Scatterer>
 struct stream_splitter_state {
-  using stage_impl = stream_stage_impl<
-    process_t, cleanup_t, random_gatherer,
-    random_topic_scatterer<element_type, std::vector<key_type>, selected_t>>;
+  using stage_impl = stream_stage_impl<process_t, cleanup_t, random_gatherer,
+                                       Scatterer>;
   intrusive_ptr<stage_impl> stage;
   static const char* name;
 };
 
-const char* stream_splitter_state::name = "stream_splitter";
+template <class Scatterer>
+const char* stream_splitter_state<Scatterer>::name = "stream_splitter";
 
-behavior stream_splitter(stateful_actor<stream_splitter_state>* self) {
+using random_lanes_scatterer =
+  random_topic_scatterer<element_type, std::vector<key_type>, selected_t>;
+
+using broadcast_lanes_scatterer =
+  broadcast_topic_scatterer<element_type, std::vector<key_type>, selected_t>;
+
+template <class Scatterer>
+behavior stream_splitter(stateful_actor<stream_splitter_state<Scatterer>>* self) {
   stream_id id{self->ctrl(),
                self->new_request_id(message_priority::normal).integer_value()};
-  using impl = stream_splitter_state::stage_impl;
+  using impl = typename stream_splitter_state<Scatterer>::stage_impl;
   self->state.stage = make_counted<impl>(self, id, process_fun, cleanup_fun);
   self->state.stage->in().continuous(true);
   // Force the splitter to collect credit until reaching 3 in order
@@ -103,7 +112,7 @@ behavior stream_splitter(stateful_actor<stream_splitter_state>* self) {
     [=](join_atom, filter_type filter) -> stream<element_type> {
       auto sid = self->streams().begin()->first;
       auto hdl = self->current_sender();
-      if (!self->add_sink<element_type>(
+      if (!self->template add_sink<element_type>(
             self->state.stage, sid, nullptr, hdl, no_stages, message_id::make(),
             stream_priority::normal, std::make_tuple()))
         return none;
@@ -199,7 +208,49 @@ public:
   }
 };
 
-using fixture = test_coordinator_fixture<config>;
+struct fixture : test_coordinator_fixture<config> {
+  /// Streams data from a single source through a splitter with a non-matching
+  /// lane and checks whether everything shuts down once the source is done.
+  template <class Scatterer>
+  void run_idle_lane_test() {
+    using batch = std::vector<element_type>;
+    using state_type = stream_splitter_state<Scatterer>;
+    auto splitter = sys.spawn(stream_splitter<Scatterer>);
+    sched.run();
+    auto d1 = sys.spawn(storage, splitter, filter_type{"key1"});
+    auto d2 = sys.spawn(storage, splitter, filter_type{"key3"});
+    sched.run();
+    auto& st = deref<stateful_actor<state_type>>(splitter).state;
+    CAF_REQUIRE_EQUAL(st.stage->out().num_paths(), 2u);
+    sys.spawn(nores_streamer, splitter);
+    // Let the handshake finish before closing the input of the splitter.
+    sched.run_once();
+    sched.run_once();
+    st.stage->in().continuous(false);
+    sched.run();
+    CAF_CHECK(st.stage->done());
+    CAF_CHECK_EQUAL(st.stage->out().num_paths(), 0u);
+    CAF_CHECK_EQUAL(deref(d1).streams().size(), 0u);
+    CAF_CHECK_EQUAL(deref(d2).streams().size(), 0u);
+    self->send(d1, get_atom::value);
+    sched.run_once();
+    self->receive(
+      [](const batch& xs) {
+        batch ys{{"key1", "a"}, {"key1", "b"}, {"key1", "c"}, {"key1", "d"}};
+        CAF_CHECK_EQUAL(xs, ys);
+      }
+    );
+    self->send(d2, get_atom::value);
+    sched.run_once();
+    self->receive(
+      [](const batch& xs) {
+        CAF_CHECK(xs.empty());
+      }
+    );
+    anon_send_exit(splitter, exit_reason::kill);
+    sched.run();
+  }
+};
 
 } // namespace <anonymous>
 
@@ -207,7 +258,7 @@ CAF_TEST_FIXTURE_SCOPE(multi_lane_streaming, fixture)
 
 CAF_TEST(fork_setup) {
   using batch = std::vector<element_type>;
-  auto splitter = sys.spawn(stream_splitter);
+  auto splitter = sys.spawn(stream_splitter<random_lanes_scatterer>);
   sched.run();
   CAF_MESSAGE("spawn first sink");
   auto d1 = sys.spawn(storage, splitter, filter_type{"key1"});
@@ -352,4 +403,12 @@ CAF_TEST(fork_setup) {
   sched.run();
 }
 
+CAF_TEST(random_topic_idle_lane) {
+  run_idle_lane_test<random_lanes_scatterer>();
+}
+
+CAF_TEST(broadcast_topic_idle_lane) {
+  run_idle_lane_test<broadcast_lanes_scatterer>();
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
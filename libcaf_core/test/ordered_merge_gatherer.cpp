@@ -0,0 +1,251 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include <vector>
+#include <algorithm>
+
+#define CAF_SUITE ordered_merge_gatherer
+#include "caf/test/dsl.hpp"
+
+#include "caf/ordered_merge_gatherer.hpp"
+
+using std::vector;
+
+using namespace caf;
+
+namespace {
+
+struct key_fn {
+  int operator()(int x) const {
+    return x;
+  }
+};
+
+using gatherer_type = ordered_merge_gatherer<int, key_fn>;
+
+struct process_t {
+  void operator()(unit_t&, downstream<int>& out, int x) {
+    out.push(x);
+  }
+};
+
+struct cleanup_t {
+  void operator()(unit_t&) {
+    // nop
+  }
+};
+
+struct merger_state {
+  using stage_impl = stream_stage_impl<process_t, cleanup_t, gatherer_type,
+                                       broadcast_scatterer<int>>;
+  intrusive_ptr<stage_impl> stage;
+  static const char* name;
+};
+
+const char* merger_state::name = "merger";
+
+behavior merger(stateful_actor<merger_state>* self) {
+  stream_id id{self->ctrl(),
+               self->new_request_id(message_priority::normal).integer_value()};
+  using impl = merger_state::stage_impl;
+  self->state.stage = make_counted<impl>(self, id, process_t{}, cleanup_t{});
+  self->state.stage->in().continuous(true);
+  // Use small credit in order to force interleaving of the sources.
+  self->state.stage->in().max_credit(5);
+  self->streams().emplace(id, self->state.stage);
+  return {
+    [=](join_atom) -> stream<int> {
+      auto sid = self->streams().begin()->first;
+      auto hdl = self->current_sender();
+      if (!self->add_sink<int>(self->state.stage, sid, nullptr, hdl, no_stages,
+                               message_id::make(), stream_priority::normal,
+                               std::make_tuple()))
+        return none;
+      self->drop_current_message_id();
+      return sid;
+    },
+    [=](const stream<int>& in) {
+      auto& mgr = self->state.stage;
+      if (!self->add_source(mgr, in.id(), none)) {
+        CAF_FAIL("add_source failed");
+      }
+      self->streams().emplace(in.id(), mgr);
+    }
+  };
+}
+
+behavior storage(event_based_actor* self, actor source) {
+  auto xs = std::make_shared<vector<int>>();
+  self->send(self * source, join_atom::value);
+  return {
+    [=](stream<int>& in) {
+      return self->make_sink(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [=](unit_t&, int x) {
+          xs->push_back(x);
+        },
+        [](unit_t&) {
+          // nop
+        }
+      );
+    },
+    [=](get_atom) {
+      return *xs;
+    }
+  };
+}
+
+// Streams `first`, `first + step`, ... up to (excluding) `last`.
+void range_source(event_based_actor* self, actor dest, int first, int last,
+                  int step) {
+  self->make_source(
+    dest,
+    [=](int& x) {
+      x = first;
+    },
+    [=](int& x, downstream<int>& out, size_t num) {
+      for (size_t i = 0; i < num && x < last; ++i, x += step)
+        out.push(x);
+    },
+    [=](const int& x) {
+      return x >= last;
+    },
+    [](expected<void>) {
+      // nop
+    }
+  );
+}
+
+behavior dummy_source() {
+  return {
+    [](int) {
+      // nop
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  vector<int> fetch_storage(const actor& hdl) {
+    vector<int> result;
+    self->send(hdl, get_atom::value);
+    sched.run();
+    self->receive(
+      [&](vector<int>& xs) {
+        result = std::move(xs);
+      }
+    );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(ordered_merge_gatherer_tests, fixture)
+
+CAF_TEST(merge_sorted_sources) {
+  auto stage = sys.spawn(merger);
+  sched.run();
+  auto sink = sys.spawn(storage, stage);
+  sched.run();
+  CAF_MESSAGE("merge multiples of 3 with multiples of 5 and all numbers >= 90");
+  sys.spawn(range_source, stage, 0, 100, 3);
+  sys.spawn(range_source, stage, 0, 100, 5);
+  sys.spawn(range_source, stage, 90, 100, 1);
+  sched.run();
+  auto& st = deref<stateful_actor<merger_state>>(stage).state;
+  CAF_CHECK_EQUAL(st.stage->in().buffered(), 0);
+  CAF_CHECK(st.stage->in().lanes().empty());
+  auto xs = fetch_storage(sink);
+  vector<int> ys;
+  for (int i = 0; i < 100; i += 3)
+    ys.push_back(i);
+  for (int i = 0; i < 100; i += 5)
+    ys.push_back(i);
+  for (int i = 90; i < 100; ++i)
+    ys.push_back(i);
+  std::sort(ys.begin(), ys.end());
+  CAF_CHECK_EQUAL(xs, ys);
+  anon_send_exit(sink, exit_reason::user_shutdown);
+  anon_send_exit(stage, exit_reason::user_shutdown);
+  sched.run();
+}
+
+CAF_TEST(credit_assignment) {
+  using batch = vector<int>;
+  gatherer_type in{self.ptr()};
+  in.max_credit(10);
+  stream_id sid{self->ctrl(), 1};
+  vector<actor> sources;
+  vector<inbound_path*> paths;
+  for (int i = 0; i < 3; ++i) {
+    sources.push_back(sys.spawn(dummy_source));
+    paths.push_back(in.add_path(sid, actor_cast<strong_actor_ptr>(
+                                       sources.back()),
+                                nullptr, stream_priority::normal, 0, false,
+                                response_promise{}));
+  }
+  auto credit = [&](size_t i) {
+    return paths[i]->assigned_credit;
+  };
+  auto lane_size = [&](size_t i) {
+    return static_cast<long>(in.lanes()[i].buf.size());
+  };
+  CAF_MESSAGE("no output while any open path has no data");
+  auto xs = make_message(batch{1, 2, 3});
+  CAF_CHECK(in.merge(paths[0], xs).empty());
+  xs = make_message(batch{10, 11});
+  CAF_CHECK(in.merge(paths[1], xs).empty());
+  CAF_CHECK_EQUAL(in.buffered(), 5);
+  CAF_MESSAGE("the path blocking the merge receives credit first");
+  in.assign_credit(10);
+  CAF_CHECK_EQUAL(credit(0), 0);
+  CAF_CHECK_EQUAL(credit(1), 0);
+  CAF_CHECK_EQUAL(credit(2), 10);
+  CAF_MESSAGE("buffer plus credit never exceeds max_credit() per path");
+  in.assign_credit(7);
+  CAF_CHECK_EQUAL(credit(0), 7);
+  CAF_CHECK_EQUAL(credit(1), 0);
+  in.assign_credit(100);
+  for (size_t i = 0; i < 3; ++i)
+    CAF_CHECK_LESS_OR_EQUAL(lane_size(i) + credit(i), in.max_credit());
+  CAF_CHECK_EQUAL(credit(1), 8);
+  CAF_MESSAGE("merging stops at the first empty lane");
+  xs = make_message(batch{2, 20});
+  auto ys = in.merge(paths[2], xs);
+  CAF_REQUIRE(ys.match_elements<batch>());
+  CAF_CHECK_EQUAL(ys.get_as<batch>(0), batch({1, 2, 2, 3}));
+  CAF_CHECK_EQUAL(in.buffered(), 3);
+  CAF_MESSAGE("removed paths with data still take part in the merge");
+  in.remove_path(sid, actor_cast<actor_addr>(sources[1]), none, true);
+  ys = in.drain();
+  CAF_CHECK(ys.empty());
+  xs = make_message(batch{30});
+  ys = in.merge(paths[0], xs);
+  CAF_REQUIRE(ys.match_elements<batch>());
+  CAF_CHECK_EQUAL(ys.get_as<batch>(0), batch({10, 11, 20}));
+  in.abort(exit_reason::user_shutdown);
+  for (auto& x : sources)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  sched.run();
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
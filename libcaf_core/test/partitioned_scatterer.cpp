@@ -0,0 +1,245 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include <set>
+#include <vector>
+
+#define CAF_SUITE partitioned_scatterer
+#include "caf/test/dsl.hpp"
+
+#include "caf/partitioner.hpp"
+#include "caf/partitioned_scatterer.hpp"
+
+using std::set;
+using std::vector;
+
+using namespace caf;
+
+namespace {
+
+struct key_fn {
+  int operator()(int x) const {
+    return x % 6;
+  }
+};
+
+using scatterer_type = partitioned_scatterer<int, key_fn>;
+
+using partitioner_type = partitioner_state<int, key_fn>;
+
+// Exposes `fan_out` for inspecting partitions without emitting batches.
+struct test_scatterer : scatterer_type {
+  using scatterer_type::scatterer_type;
+  using scatterer_type::fan_out;
+};
+
+behavior storage(event_based_actor* self, actor source) {
+  auto xs = std::make_shared<vector<int>>();
+  self->send(self * source, join_atom::value);
+  return {
+    [=](stream<int>& in) {
+      return self->make_sink(
+        in,
+        [](unit_t&) {
+          // nop
+        },
+        [=](unit_t&, int x) {
+          xs->push_back(x);
+        },
+        [](unit_t&) {
+          // nop
+        }
+      );
+    },
+    [=](get_atom) {
+      return *xs;
+    }
+  };
+}
+
+void int_source(event_based_actor* self, actor dest, int num_values) {
+  self->make_source(
+    dest,
+    [](int& x) {
+      x = 0;
+    },
+    [=](int& x, downstream<int>& out, size_t num) {
+      auto n = std::min(static_cast<int>(num), num_values - x);
+      for (int i = 0; i < n; ++i)
+        out.push(x++);
+    },
+    [=](const int& x) {
+      return x == num_values;
+    },
+    [](expected<void>) {
+      // nop
+    }
+  );
+}
+
+behavior dummy_sink() {
+  return {
+    [](int) {
+      // nop
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  vector<int> fetch_storage(const actor& hdl) {
+    vector<int> result;
+    self->send(hdl, get_atom::value);
+    sched.run();
+    self->receive(
+      [&](vector<int>& xs) {
+        result = std::move(xs);
+      }
+    );
+    return result;
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(partitioned_scatterer_tests, fixture)
+
+CAF_TEST(consistent_assignment) {
+  scatterer_type out{self.ptr()};
+  stream_id sid{self->ctrl(), 1};
+  vector<actor> sinks;
+  for (int i = 0; i < 4; ++i) {
+    sinks.push_back(sys.spawn(dummy_sink));
+    out.add_path(sid, nullptr, actor_cast<strong_actor_ptr>(sinks.back()),
+                 no_stages, message_id::make(), make_message(),
+                 stream_priority::normal, false);
+  }
+  CAF_REQUIRE_EQUAL(out.partitions().size(), 4u);
+  auto owner = [&](int x) {
+    return out.select(x)->path->hdl;
+  };
+  vector<strong_actor_ptr> before;
+  for (int i = 0; i < 60; ++i)
+    before.push_back(owner(i));
+  CAF_MESSAGE("without credit, all elements remain buffered");
+  for (int i = 0; i < 60; ++i)
+    out.push(i);
+  out.emit_batches();
+  CAF_CHECK_EQUAL(out.buffered(), 60);
+  CAF_MESSAGE("removing a sink only moves its own keys");
+  auto removed = actor_cast<strong_actor_ptr>(sinks[1]);
+  out.remove_path(sid, removed, none, true);
+  CAF_REQUIRE_EQUAL(out.partitions().size(), 3u);
+  CAF_CHECK_EQUAL(out.buffered(), 60);
+  for (int i = 0; i < 60; ++i) {
+    if (before[static_cast<size_t>(i)] != removed)
+      CAF_CHECK_EQUAL(owner(i), before[static_cast<size_t>(i)]);
+    else
+      CAF_CHECK_NOT_EQUAL(owner(i), removed);
+  }
+  CAF_MESSAGE("elements of the removed sink go to the remaining sinks");
+  out.emit_batches();
+  for (auto& p : out.partitions())
+    for (auto i = p.buf.begin(); i != p.buf.end(); ++i)
+      CAF_CHECK_EQUAL(owner(*i), p.path->hdl);
+  CAF_CHECK_EQUAL(out.buffered(), 60);
+  CAF_MESSAGE("adding a sink only moves keys to the new sink");
+  vector<strong_actor_ptr> after_removal;
+  for (int i = 0; i < 60; ++i)
+    after_removal.push_back(owner(i));
+  sinks.push_back(sys.spawn(dummy_sink));
+  auto added = actor_cast<strong_actor_ptr>(sinks.back());
+  out.add_path(sid, nullptr, added, no_stages, message_id::make(),
+               make_message(), stream_priority::normal, false);
+  size_t moved = 0;
+  for (int i = 0; i < 60; ++i) {
+    if (owner(i) != after_removal[static_cast<size_t>(i)]) {
+      CAF_CHECK_EQUAL(owner(i), added);
+      ++moved;
+    }
+  }
+  CAF_CHECK_LESS(moved, 60u);
+  out.abort(exit_reason::user_shutdown);
+  for (auto& x : sinks)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  sched.run();
+}
+
+CAF_TEST(skewed_keys) {
+  test_scatterer out{self.ptr()};
+  stream_id sid{self->ctrl(), 1};
+  vector<actor> sinks;
+  for (int i = 0; i < 3; ++i) {
+    sinks.push_back(sys.spawn(dummy_sink));
+    auto ptr = out.add_path(sid, nullptr,
+                            actor_cast<strong_actor_ptr>(sinks.back()),
+                            no_stages, message_id::make(), make_message(),
+                            stream_priority::normal, false);
+    ptr->open_credit = 5;
+  }
+  CAF_MESSAGE("all elements have the same key");
+  int pushed = 0;
+  for (int round = 0; round < 10; ++round) {
+    auto n = out.credit() - out.buffered();
+    CAF_REQUIRE_GREATER_OR_EQUAL(n, 0);
+    for (long i = 0; i < n; ++i)
+      out.push(6 * pushed++);
+    out.fan_out();
+    for (auto& p : out.partitions())
+      CAF_CHECK_LESS_OR_EQUAL(static_cast<long>(p.buf.size()),
+                              p.path->open_credit);
+  }
+  CAF_CHECK_EQUAL(pushed, 5);
+  CAF_CHECK_EQUAL(out.select(0)->buf.size(), 5u);
+  CAF_CHECK_EQUAL(out.credit(), out.buffered());
+  out.abort(exit_reason::user_shutdown);
+  for (auto& x : sinks)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  sched.run();
+}
+
+CAF_TEST(keyed_pipeline) {
+  auto stage = sys.spawn(partitioner<int, key_fn>);
+  sched.run();
+  vector<actor> sinks;
+  for (int i = 0; i < 3; ++i) {
+    sinks.push_back(sys.spawn(storage, stage));
+    sched.run();
+  }
+  sys.spawn(int_source, stage, 300);
+  sched.run();
+  set<int> all;
+  set<int> keys;
+  for (auto& sink : sinks) {
+    set<int> sink_keys;
+    for (auto x : fetch_storage(sink)) {
+      CAF_CHECK(all.insert(x).second);
+      sink_keys.insert(x % 6);
+    }
+    for (auto k : sink_keys)
+      CAF_CHECK(keys.insert(k).second);
+  }
+  CAF_CHECK_EQUAL(all.size(), 300u);
+  CAF_CHECK_EQUAL(keys.size(), 6u);
+  for (auto& sink : sinks)
+    anon_send_exit(sink, exit_reason::user_shutdown);
+  anon_send_exit(stage, exit_reason::user_shutdown);
+  sched.run();
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
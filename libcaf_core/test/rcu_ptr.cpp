@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE rcu_ptr
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "caf/detail/rcu_ptr.hpp"
+
+using namespace caf;
+
+using caf::detail::rcu_ptr;
+
+namespace {
+
+// Writers always update both members, i.e., readers must never observe a
+// value with `x != y`.
+struct point {
+  long x;
+  long y;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(single_threaded) {
+  rcu_ptr<point> ptr{point{1, 1}};
+  {
+    auto val = ptr.read();
+    CAF_CHECK_EQUAL(val->x, 1);
+  }
+  ptr.update([](point& p) {
+    ++p.x;
+    ++p.y;
+  });
+  CAF_CHECK_EQUAL(ptr.read()->x, 2);
+  ptr.reset(point{10, 10});
+  CAF_CHECK_EQUAL(ptr.read()->y, 10);
+}
+
+CAF_TEST(concurrent_readers_and_writers) {
+  constexpr size_t num_readers = 4;
+  constexpr size_t num_writers = 2;
+  constexpr long updates_per_writer = 2000;
+  rcu_ptr<point> ptr{point{0, 0}};
+  std::atomic<bool> done{false};
+  std::atomic<size_t> reads{0};
+  std::atomic<size_t> violations{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_readers; ++i)
+    threads.emplace_back([&] {
+      long last = 0;
+      while (!done) {
+        auto val = ptr.read();
+        // values never go backwards and always satisfy the invariant
+        if (val->x != val->y || val->x < last)
+          ++violations;
+        last = val->x;
+        ++reads;
+      }
+    });
+  for (size_t i = 0; i < num_writers; ++i)
+    threads.emplace_back([&] {
+      for (long j = 0; j < updates_per_writer; ++j)
+        ptr.update([](point& p) {
+          ++p.x;
+          ++p.y;
+        });
+    });
+  for (size_t i = num_readers; i < threads.size(); ++i)
+    threads[i].join();
+  done = true;
+  for (size_t i = 0; i < num_readers; ++i)
+    threads[i].join();
+  CAF_CHECK_EQUAL(violations.load(), 0u);
+  CAF_CHECK_GREATER(reads.load(), 0u);
+  auto val = ptr.read();
+  CAF_CHECK_EQUAL(val->x, static_cast<long>(num_writers) * updates_per_writer);
+  CAF_CHECK_EQUAL(val->y, static_cast<long>(num_writers) * updates_per_writer);
+}
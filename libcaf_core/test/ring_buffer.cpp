@@ -0,0 +1,208 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE ring_buffer
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <string>
+#include <iterator>
+#include <stdexcept>
+
+#include "caf/message.hpp"
+#include "caf/broadcast_scatterer.hpp"
+
+#include "caf/detail/ring_buffer.hpp"
+
+using namespace caf;
+
+using caf::detail::ring_buffer;
+
+namespace {
+
+std::vector<int> to_vec(const ring_buffer<int>& xs) {
+  return {xs.begin(), xs.end()};
+}
+
+#ifndef CAF_NO_EXCEPTIONS
+
+// Throws when copying the element with value `throw_on`. Moving may throw in
+// theory, hence the buffer must copy on reallocation.
+struct fragile {
+  static int throw_on;
+
+  int value;
+
+  fragile(int x) : value(x) {
+    // nop
+  }
+
+  fragile(const fragile& other) : value(other.value) {
+    if (value == throw_on)
+      throw std::runtime_error("fragile");
+  }
+
+  fragile(fragile&& other) : value(other.value) {
+    // nop
+  }
+
+  fragile& operator=(const fragile&) = default;
+};
+
+int fragile::throw_on = -1;
+
+template <class F>
+bool throws(F f) {
+  try {
+    f();
+  } catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+#endif // CAF_NO_EXCEPTIONS
+
+} // namespace <anonymous>
+
+CAF_TEST(fifo_order) {
+  ring_buffer<int> xs;
+  CAF_CHECK(xs.empty());
+  for (int i = 1; i <= 5; ++i)
+    xs.push_back(i);
+  CAF_CHECK_EQUAL(xs.size(), 5u);
+  CAF_CHECK_EQUAL(xs.front(), 1);
+  CAF_CHECK_EQUAL(xs.back(), 5);
+  xs.pop_front();
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({2, 3, 4, 5}));
+  std::vector<int> ys;
+  xs.move_front(3, std::back_inserter(ys));
+  CAF_CHECK_EQUAL(ys, std::vector<int>({2, 3, 4}));
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({5}));
+  xs.insert(xs.begin(), 4);
+  xs.insert(xs.end(), 6);
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({4, 5, 6}));
+  xs.clear();
+  CAF_CHECK(xs.empty());
+}
+
+CAF_TEST(wrap_around) {
+  ring_buffer<std::string> xs;
+  xs.reserve(4);
+  auto cap = xs.capacity();
+  // keep the buffer partially filled while moving its front around
+  for (int i = 0; i < 100; ++i) {
+    xs.emplace_back(std::to_string(i));
+    if (xs.size() > 3)
+      xs.pop_front();
+  }
+  CAF_CHECK_EQUAL(xs.capacity(), cap);
+  CAF_REQUIRE_EQUAL(xs.size(), 3u);
+  CAF_CHECK_EQUAL(xs[0], "97");
+  CAF_CHECK_EQUAL(xs[1], "98");
+  CAF_CHECK_EQUAL(xs[2], "99");
+  // growing preserves the order of elements
+  for (size_t i = 0; i < cap; ++i)
+    xs.emplace_back("x");
+  CAF_CHECK_GREATER(xs.capacity(), cap);
+  CAF_CHECK_EQUAL(xs.front(), "97");
+  CAF_CHECK_EQUAL(xs.size(), cap + 3);
+  auto ys = xs;
+  CAF_CHECK(std::equal(xs.begin(), xs.end(), ys.begin()));
+}
+
+CAF_TEST(self_referencing_insertions) {
+  ring_buffer<std::string> xs;
+  xs.reserve(4);
+  auto cap = xs.capacity();
+  for (size_t i = 0; i < cap; ++i)
+    xs.emplace_back(std::to_string(i));
+  // the argument refers to an element that moves to the new storage
+  xs.push_back(xs.front());
+  CAF_CHECK_GREATER(xs.capacity(), cap);
+  CAF_CHECK_EQUAL(xs.back(), "0");
+  ring_buffer<std::string> ys;
+  ys.reserve(4);
+  for (size_t i = 0; i < cap; ++i)
+    ys.emplace_back(std::to_string(i));
+  ys.push_front(ys.back());
+  CAF_CHECK_EQUAL(ys.front(), std::to_string(cap - 1));
+  CAF_CHECK_EQUAL(ys[1], "0");
+}
+
+CAF_TEST(deque_interface) {
+  ring_buffer<int> xs;
+  for (int i = 1; i <= 5; ++i)
+    xs.push_back(i);
+  xs.push_front(0);
+  xs.emplace_front(-1);
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({-1, 0, 1, 2, 3, 4, 5}));
+  xs.pop_back();
+  CAF_CHECK_EQUAL(xs.back(), 4);
+  auto i = xs.erase(xs.begin() + 2, xs.begin() + 4);
+  CAF_CHECK_EQUAL(*i, 3);
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({-1, 0, 3, 4}));
+  xs.erase(xs.begin());
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({0, 3, 4}));
+  CAF_CHECK(xs.erase(xs.begin() + 2) == xs.end());
+  CAF_CHECK_EQUAL(to_vec(xs), std::vector<int>({0, 3}));
+}
+
+#ifndef CAF_NO_EXCEPTIONS
+
+CAF_TEST(strong_exception_guarantee) {
+  ring_buffer<fragile> xs;
+  xs.reserve(4);
+  auto cap = xs.capacity();
+  for (size_t i = 0; i < cap; ++i)
+    xs.emplace_back(static_cast<int>(i));
+  fragile::throw_on = 1;
+  CAF_CHECK(throws([&] { xs.reserve(cap + 1); }));
+  CAF_CHECK(throws([&] { xs.emplace_back(42); }));
+  fragile::throw_on = -1;
+  CAF_CHECK_EQUAL(xs.capacity(), cap);
+  CAF_REQUIRE_EQUAL(xs.size(), cap);
+  for (size_t i = 0; i < cap; ++i)
+    CAF_CHECK_EQUAL(xs[i].value, static_cast<int>(i));
+}
+
+#endif // CAF_NO_EXCEPTIONS
+
+CAF_TEST(batch_recycling) {
+  broadcast_scatterer<int> out{nullptr};
+  for (int i = 1; i <= 10; ++i)
+    out.push(i);
+  auto x = out.make_batch(3);
+  CAF_REQUIRE(x.match_elements<std::vector<int>>());
+  CAF_CHECK_EQUAL(x.get_as<std::vector<int>>(0), std::vector<int>({1, 2, 3}));
+  auto x_data = &*x.cvals();
+  CAF_MESSAGE("allocate a new batch while receivers still hold the first");
+  auto y = out.make_batch(3);
+  CAF_CHECK(&*y.cvals() != x_data);
+  CAF_CHECK_EQUAL(y.get_as<std::vector<int>>(0), std::vector<int>({4, 5, 6}));
+  CAF_MESSAGE("reuse the first batch after all receivers released it");
+  x.reset();
+  auto z = out.make_batch(4);
+  CAF_CHECK(&*z.cvals() == x_data);
+  CAF_CHECK_EQUAL(z.get_as<std::vector<int>>(0),
+                  std::vector<int>({7, 8, 9, 10}));
+  CAF_CHECK_EQUAL(out.buffered(), 0);
+}
@@ -308,6 +308,41 @@ CAF_TEST(custom_struct) {
   CAF_CHECK_EQUAL(rs, x);
 }
 
+CAF_TEST(arithmetic_vectors) {
+  // use more elements than the scratch buffers of the serializers can hold
+  std::vector<int16_t> xs(300);
+  std::vector<double> ys(300);
+  for (size_t i = 0; i < xs.size(); ++i) {
+    xs[i] = static_cast<int16_t>(static_cast<int>(i) * 100 - 15000);
+    ys[i] = static_cast<double>(i) * 0.5;
+  }
+  CAF_CHECK_EQUAL(roundtrip(xs), xs);
+  CAF_CHECK_EQUAL(roundtrip(ys), ys);
+  CAF_MESSAGE("bulk encoding produces the same bytes as per-element encoding");
+  vector<char> buf;
+  binary_serializer bs{&context, buf};
+  auto s = xs.size();
+  bs.begin_sequence(s);
+  for (auto& x : xs)
+    bs(x);
+  bs.end_sequence();
+  CAF_CHECK_EQUAL(serialize(xs), buf);
+}
+
+CAF_TEST(truncated_arithmetic_vectors) {
+  CAF_MESSAGE("claim far more elements than the buffer contains");
+  vector<char> buf;
+  binary_serializer bs{&context, buf};
+  size_t s = std::numeric_limits<uint32_t>::max();
+  bs.begin_sequence(s);
+  bs(int32_t{1});
+  bs(int32_t{2});
+  std::vector<int32_t> xs;
+  binary_deserializer bd{&context, buf};
+  CAF_CHECK_NOT_EQUAL(bd(xs), none);
+  CAF_CHECK_LESS_OR_EQUAL(xs.size(), 4096u);
+}
+
 CAF_TEST(atoms) {
   auto foo = atom("foo");
   CAF_CHECK_EQUAL(foo, roundtrip(foo));
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE stream_window
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+#include <algorithm>
+
+#include "caf/stream_window.hpp"
+
+using namespace caf;
+
+namespace {
+
+using buf_type = downstream<int>::queue_type;
+
+template <class Window>
+std::vector<int> run(Window& w, const std::vector<int>& xs) {
+  buf_type buf;
+  downstream<int> out{buf};
+  for (auto x : xs)
+    w(out, x);
+  return {buf.begin(), buf.end()};
+}
+
+// interprets each value as its own timestamp in nanoseconds
+struct value_as_time {
+  timestamp operator()(int x) const {
+    return timestamp{timespan{x}};
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST(tumbling_count_windows) {
+  count_window<sum_aggregate<int>> w{3};
+  CAF_CHECK_EQUAL(run(w, {1, 2, 3, 4, 5, 6, 7, 8}),
+                  std::vector<int>({6, 15}));
+}
+
+CAF_TEST(sliding_count_windows) {
+  count_window<sum_aggregate<int>> sums{3, 1};
+  CAF_CHECK_EQUAL(run(sums, {1, 2, 3, 4, 5}), std::vector<int>({6, 9, 12}));
+  count_window<max_aggregate<int>> maxs{3, 2};
+  CAF_CHECK_EQUAL(run(maxs, {5, 1, 2, 7, 1, 0, 3}),
+                  std::vector<int>({5, 7, 3}));
+}
+
+CAF_TEST(hopping_count_windows) {
+  count_window<min_aggregate<int>> w{2, 3};
+  CAF_CHECK_EQUAL(run(w, {4, 3, 9, 8, 7, 1, 5, 6}),
+                  std::vector<int>({3, 7, 5}));
+}
+
+CAF_TEST(two_stacks_match_rescanning) {
+  // compare against recomputing each window from scratch
+  std::vector<int> xs;
+  for (int i = 0; i < 100; ++i)
+    xs.push_back((i * 37) % 101);
+  for (size_t size = 1; size < 8; ++size) {
+    for (size_t slide = 1; slide < 10; ++slide) {
+      count_window<min_aggregate<int>> w{size, slide};
+      std::vector<int> expected;
+      for (size_t end = size; end <= xs.size(); end += slide)
+        expected.push_back(*std::min_element(xs.begin() + (end - size),
+                                             xs.begin() + end));
+      CAF_CHECK_EQUAL(run(w, xs), expected);
+    }
+  }
+}
+
+CAF_TEST(tumbling_time_windows) {
+  time_window<sum_aggregate<int>, value_as_time> w{timespan{10}};
+  // windows: [0, 10) = 1 + 5, [10, 20) = 12, [20, 30) is empty,
+  // [30, 40) = 31 + 35, and [40, 50) remains incomplete
+  CAF_CHECK_EQUAL(run(w, {1, 5, 12, 31, 35, 40}),
+                  std::vector<int>({6, 12, 66}));
+}
+
+CAF_TEST(sliding_time_windows) {
+  auto w = make_time_window<max_aggregate<int>>(timespan{10}, timespan{5},
+                                                value_as_time{});
+  // windows: [0, 10) = 7, [5, 15) = 12, [10, 20) = 12, [15, 25) = 21
+  CAF_CHECK_EQUAL(run(w, {2, 7, 12, 21, 26}),
+                  std::vector<int>({7, 12, 12, 21}));
+}
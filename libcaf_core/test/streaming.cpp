@@ -18,6 +18,7 @@
  ******************************************************************************/
 
 #include <string>
+#include <chrono>
 #include <numeric>
 #include <fstream>
 #include <iostream>
@@ -73,6 +74,40 @@ behavior file_reader(stateful_actor<file_reader_state>* self) {
   };
 }
 
+struct slow_reader_state {
+  static const char* name;
+};
+
+const char* slow_reader_state::name = "slow_reader";
+
+behavior slow_reader(stateful_actor<slow_reader_state>* self) {
+  using buf = std::deque<int>;
+  return {
+    [=](std::string& fname) -> stream<int> {
+      auto result = self->make_source(
+        std::forward_as_tuple(std::move(fname)),
+        [&](buf& xs) {
+          xs = buf{1, 2, 3, 4, 5, 6, 7, 8, 9};
+        },
+        // produce at most 3 elements at a time
+        [=](buf& xs, downstream<int>& out, size_t num) {
+          auto n = std::min({num, xs.size(), size_t{3}});
+          for (size_t i = 0; i < n; ++i)
+            out.push(xs[i]);
+          xs.erase(xs.begin(), xs.begin() + static_cast<ptrdiff_t>(n));
+        },
+        [=](const buf& xs) {
+          return xs.empty();
+        }
+      );
+      auto& out = result.ptr()->out();
+      out.min_batch_size(5);
+      out.max_batch_delay(duration{std::chrono::milliseconds(1)});
+      return result;
+    }
+  };
+}
+
 struct streamer_state {
   static const char* name;
 };
@@ -539,6 +574,33 @@ CAF_TEST(depth3_pipeline_order2) {
   expect((int), from(sink).to(self).with(25));
 }
 
+CAF_TEST(delayed_partial_batches) {
+  auto source = sys.spawn(slow_reader);
+  auto sink = sys.spawn(sum_up);
+  auto pipeline = sink * source;
+  sched.run();
+  self->send(pipeline, "test.txt");
+  expect((std::string), from(self).to(source).with("test.txt"));
+  expect((stream_msg::open),
+         from(self).to(sink).with(_, source, _, _, _, _, false));
+  expect((stream_msg::ack_open), from(sink).to(source).with(_, _, 5, _, false));
+  CAF_MESSAGE("source holds back 3 elements until the batch delay expires");
+  CAF_CHECK(!sched.has_job());
+  CAF_REQUIRE_EQUAL(sched.delayed_messages.size(), 1u);
+  sched.trigger_timeouts();
+  sched.run_once();
+  expect((stream_msg::batch),
+         from(source).to(sink).with(3, std::vector<int>{1, 2, 3}, 0));
+  CAF_MESSAGE("run remaining batches");
+  while (sched.has_job() || !sched.delayed_messages.empty()) {
+    sched.run();
+    sched.trigger_timeouts();
+  }
+  CAF_CHECK(deref(source).streams().empty());
+  CAF_CHECK(deref(sink).streams().empty());
+  CAF_CHECK_EQUAL(fetch_result(), 45);
+}
+
 CAF_TEST(broken_pipeline_stramer) {
   CAF_MESSAGE("streams must abort if a stage fails to initialize its state");
   auto stage = sys.spawn(broken_filter);
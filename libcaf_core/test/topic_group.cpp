@@ -0,0 +1,163 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright (C) 2011 - 2017                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE topic_group
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/test/dsl.hpp"
+
+#include "caf/detail/topic_trie.hpp"
+
+using namespace caf;
+
+namespace {
+
+struct collector_state {
+  std::vector<int> xs;
+};
+
+using collector_actor = stateful_actor<collector_state>;
+
+behavior collector_impl(collector_actor* self) {
+  return {
+    [=](int x) {
+      self->state.xs.push_back(x);
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  ~fixture() {
+    // the group module blocks on its broker while shutting down
+    sched.run();
+    sched.inline_all_enqueues();
+  }
+
+  group get(const char* topic) {
+    auto res = sys.groups().get("topic", topic);
+    CAF_REQUIRE(res);
+    return std::move(*res);
+  }
+
+  // returns all messages `x` received since the last call
+  std::vector<int> received(const actor& x) {
+    sched.run();
+    std::vector<int> result;
+    result.swap(deref<collector_actor>(x).state.xs);
+    return result;
+  }
+};
+
+using ivec = std::vector<int>;
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(topic_group_tests, fixture)
+
+CAF_TEST(patterns) {
+  using detail::topic_trie;
+  CAF_CHECK(topic_trie::valid_pattern("sensors"));
+  CAF_CHECK(topic_trie::valid_pattern("sensors/eu/*/temp"));
+  CAF_CHECK(topic_trie::valid_pattern("sensors/**"));
+  CAF_CHECK(!topic_trie::valid_pattern(""));
+  CAF_CHECK(!topic_trie::valid_pattern("sensors//temp"));
+  CAF_CHECK(!topic_trie::valid_pattern("sensors/**/temp"));
+  CAF_CHECK(topic_trie::is_pattern("sensors/*/temp"));
+  CAF_CHECK(!topic_trie::is_pattern("sensors/eu/temp"));
+}
+
+CAF_TEST(pattern_matching) {
+  using detail::topic_trie;
+  CAF_CHECK(topic_trie::matches("sensors/eu/*/temp", "sensors/eu/de/temp"));
+  CAF_CHECK(topic_trie::matches("sensors/**", "sensors"));
+  CAF_CHECK(topic_trie::matches("sensors/**", "sensors/eu/de/temp"));
+  CAF_CHECK(topic_trie::matches("sensors/eu", "sensors/eu"));
+  CAF_CHECK(!topic_trie::matches("sensors/eu/*/temp", "sensors/eu/de"));
+  CAF_CHECK(!topic_trie::matches("sensors/*", "sensors/eu/de"));
+  CAF_CHECK(!topic_trie::matches("sensors/eu", "sensors/us"));
+}
+
+CAF_TEST(trie_matching) {
+  auto a = sys.spawn(collector_impl);
+  auto b = sys.spawn(collector_impl);
+  auto c = sys.spawn(collector_impl);
+  auto ptr = [](const actor& x) {
+    return actor_cast<strong_actor_ptr>(x);
+  };
+  detail::topic_trie trie;
+  CAF_CHECK(trie.add("sensors/eu/*/temp", ptr(a)));
+  CAF_CHECK(trie.add("sensors/**", ptr(b)));
+  CAF_CHECK(trie.add("sensors/eu/de/temp", ptr(c)));
+  CAF_CHECK(trie.add("sensors/eu/de/temp", ptr(b)));
+  CAF_CHECK(!trie.add("sensors/**", ptr(b)));
+  CAF_CHECK_EQUAL(trie.size(), 4u);
+  CAF_CHECK_EQUAL(trie.match("sensors/eu/de/temp").size(), 3u);
+  CAF_CHECK_EQUAL(trie.match("sensors/eu/fr/temp").size(), 2u);
+  CAF_CHECK_EQUAL(trie.match("sensors").size(), 1u);
+  CAF_CHECK_EQUAL(trie.match("sensors/eu/de/humidity").size(), 1u);
+  CAF_CHECK_EQUAL(trie.match("actuators/eu/de/temp").size(), 0u);
+  CAF_CHECK(trie.erase("sensors/**", ptr(b).get()));
+  CAF_CHECK(!trie.erase("sensors/**", ptr(b).get()));
+  CAF_CHECK_EQUAL(trie.match("sensors/eu/fr/temp").size(), 1u);
+  trie.clear();
+  CAF_CHECK_EQUAL(trie.size(), 0u);
+  for (auto& x : {a, b, c})
+    anon_send_exit(x, exit_reason::user_shutdown);
+}
+
+CAF_TEST(publish_subscribe) {
+  CAF_CHECK(!sys.groups().get("topic", "sensors/**/temp"));
+  auto all = sys.spawn(collector_impl);
+  auto eu_temp = sys.spawn(collector_impl);
+  sched.run();
+  get("sensors/**").subscribe(actor_cast<strong_actor_ptr>(all));
+  get("sensors/eu/*/temp").subscribe(actor_cast<strong_actor_ptr>(eu_temp));
+  auto de_temp = get("sensors/eu/de/temp");
+  auto de_humidity = get("sensors/eu/de/humidity");
+  CAF_CHECK_EQUAL(de_temp, get("sensors/eu/de/temp"));
+  self->send(de_temp, 1);
+  CAF_CHECK_EQUAL(received(all), ivec({1}));
+  CAF_CHECK_EQUAL(received(eu_temp), ivec({1}));
+  self->send(de_humidity, 2);
+  CAF_CHECK_EQUAL(received(all), ivec({2}));
+  CAF_CHECK_EQUAL(received(eu_temp), ivec());
+  // subscriptions invalidate cached matches
+  auto eu_temp_ptr = actor_cast<actor_control_block*>(eu_temp);
+  get("sensors/eu/*/temp").unsubscribe(eu_temp_ptr);
+  self->send(de_temp, 3);
+  CAF_CHECK_EQUAL(received(all), ivec({3}));
+  CAF_CHECK_EQUAL(received(eu_temp), ivec());
+  get("sensors/eu/de/*").subscribe(actor_cast<strong_actor_ptr>(eu_temp));
+  self->send(de_humidity, 4);
+  self->send(de_temp, 5);
+  CAF_CHECK_EQUAL(received(all), ivec({4, 5}));
+  CAF_CHECK_EQUAL(received(eu_temp), ivec({4, 5}));
+  get("sensors/**").unsubscribe(actor_cast<actor_control_block*>(all));
+  get("sensors/eu/de/*").unsubscribe(eu_temp_ptr);
+  anon_send_exit(all, exit_reason::user_shutdown);
+  anon_send_exit(eu_temp, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
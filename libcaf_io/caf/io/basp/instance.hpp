@@ -148,6 +148,12 @@ public:
                 const strong_actor_ptr& receiver,
                 message_id mid, const message& msg);
 
+  /// Sends `msg` to all remote `receivers`, serializing its payload only
+  /// once. Returns the number of receivers that could not be reached.
+  size_t multicast(execution_unit* ctx, const strong_actor_ptr& sender,
+                   const std::vector<strong_actor_ptr>& receivers,
+                   const message& msg);
+
   /// Returns the actor namespace associated to this BASP protocol instance.
   proxy_registry& proxies() {
     return callee_.proxies();
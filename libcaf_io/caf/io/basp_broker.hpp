@@ -25,11 +25,13 @@
 #include <string>
 #include <future>
 #include <vector>
+#include <utility>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "caf/stateful_actor.hpp"
 #include "caf/proxy_registry.hpp"
+#include "caf/mailbox_element.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/binary_deserializer.hpp"
 #include "caf/forwarding_actor_proxy.hpp"
@@ -155,6 +157,37 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // actor
   void handle_down_msg(down_msg&);
 
+  // a stream message waiting for delivery to its receiver
+  using held_stream_msg = std::pair<strong_actor_ptr, mailbox_element_ptr>;
+
+  // stores state for throttling stream credit received over a connection,
+  // exists only while the broker receives write events for the connection
+  struct stream_credit_state {
+    // bytes waiting for transmission according to the last write event
+    size_t pending_bytes = 0;
+    // stream messages held back while `pending_bytes` exceeds the limit
+    std::vector<held_stream_msg> held_back;
+  };
+
+  // keeps track of all connections carrying stream credit to local sources
+  std::unordered_map<connection_handle, stream_credit_state> stream_credit;
+
+  // maximum number of unsent bytes on a connection before holding back
+  // stream credit for local sources, 0 disables throttling
+  size_t max_pending_stream_bytes;
+
+  // holds back `ptr` if it carries stream credit for a local source while
+  // the current connection has too many unsent bytes, returns whether
+  // `ptr` was held back
+  bool hold_back_stream_msg(strong_actor_ptr& dest, mailbox_element_ptr& ptr);
+
+  // updates the number of unsent bytes for a connection and releases stream
+  // messages once it drops below the limit
+  void handle_data_transferred(const data_transferred_msg& msg);
+
+  // delivers all stream messages held back in `st`
+  void release_held_back(stream_credit_state& st);
+
   static const char* name;
 };
 
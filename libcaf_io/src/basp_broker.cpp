@@ -20,11 +20,13 @@
 #include "caf/io/basp_broker.hpp"
 
 #include <limits>
+#include <algorithm>
 #include <chrono>
 
 #include "caf/sec.hpp"
 #include "caf/send.hpp"
 #include "caf/after.hpp"
+#include "caf/stream_msg.hpp"
 #include "caf/make_counted.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/actor_system_config.hpp"
@@ -51,7 +53,9 @@ basp_broker_state::basp_broker_state(broker* selfptr)
     : basp::instance::callee(selfptr->system(),
                              static_cast<proxy_registry::backend&>(*this)),
       self(selfptr),
-      instance(selfptr, *this) {
+      instance(selfptr, *this),
+      max_pending_stream_bytes(
+        selfptr->system().config().middleman_max_pending_stream_bytes) {
   CAF_ASSERT(this_node() != none);
 }
 
@@ -279,9 +283,73 @@ void basp_broker_state::deliver(const node_id& src_nid, actor_id src_aid,
     return;
   }
   self->parent().notify<hook::message_received>(src_nid, src, dest, mid, msg);
-  dest->enqueue(make_mailbox_element(std::move(src), mid, std::move(stages),
-                                      std::move(msg)),
-                nullptr);
+  auto is_stream_msg = msg.match_elements<stream_msg>();
+  auto ptr = make_mailbox_element(std::move(src), mid, std::move(stages),
+                                  std::move(msg));
+  if (is_stream_msg && hold_back_stream_msg(dest, ptr))
+    return;
+  dest->enqueue(std::move(ptr), nullptr);
+}
+
+bool basp_broker_state::hold_back_stream_msg(strong_actor_ptr& dest,
+                                             mailbox_element_ptr& ptr) {
+  if (max_pending_stream_bytes == 0 || this_context == nullptr)
+    return false;
+  auto hdl = this_context->hdl;
+  auto i = stream_credit.find(hdl);
+  if (i == stream_credit.end()) {
+    // start tracking write progress once streams run over this connection
+    CAF_LOG_DEBUG("enable stream credit throttling for" << CAF_ARG(hdl));
+    self->ack_writes(hdl, true);
+    stream_credit.emplace(hdl, stream_credit_state{});
+    return false;
+  }
+  auto& st = i->second;
+  // once we hold back a message, we hold back all subsequent stream messages
+  // between the same pair of actors as well in order to preserve ordering
+  auto same_pair = [&](const held_stream_msg& x) {
+    return x.first == dest && x.second->sender == ptr->sender;
+  };
+  if (std::none_of(st.held_back.begin(), st.held_back.end(), same_pair)) {
+    if (st.pending_bytes <= max_pending_stream_bytes)
+      return false;
+    auto& sm = ptr->content().get_as<stream_msg>(0);
+    if (!holds_alternative<stream_msg::ack_open>(sm.content)
+        && !holds_alternative<stream_msg::ack_batch>(sm.content))
+      return false;
+  }
+  CAF_LOG_DEBUG("hold back stream message" << CAF_ARG(hdl)
+                << CAF_ARG(st.pending_bytes));
+  st.held_back.emplace_back(std::move(dest), std::move(ptr));
+  return true;
+}
+
+void basp_broker_state::handle_data_transferred(
+  const data_transferred_msg& msg) {
+  auto i = stream_credit.find(msg.handle);
+  if (i == stream_credit.end())
+    return;
+  auto& st = i->second;
+  st.pending_bytes = msg.remaining;
+  if (st.pending_bytes > max_pending_stream_bytes)
+    return;
+  release_held_back(st);
+  // stop tracking write progress until the next stream message arrives,
+  // since write events for every chunk are expensive and our estimate would
+  // become stale without them anyway
+  CAF_LOG_DEBUG("disable stream credit throttling for" << CAF_ARG(msg.handle));
+  self->ack_writes(msg.handle, false);
+  stream_credit.erase(i);
+}
+
+void basp_broker_state::release_held_back(stream_credit_state& st) {
+  if (st.held_back.empty())
+    return;
+  CAF_LOG_DEBUG("release held back stream messages"
+                << CAF_ARG2("num", st.held_back.size()));
+  for (auto& x : st.held_back)
+    x.first->enqueue(std::move(x.second), nullptr);
+  st.held_back.clear();
 }
 
 void basp_broker_state::learned_new_node(const node_id& nid) {
@@ -474,6 +542,13 @@ void basp_broker_state::cleanup(connection_handle hdl) {
     return none;
   });
   instance.tbl().erase_direct(hdl, cb);
+  // Deliver held back stream messages, since they no longer wait for any
+  // write progress on `hdl`.
+  auto j = stream_credit.find(hdl);
+  if (j != stream_credit.end()) {
+    release_held_back(j->second);
+    stream_credit.erase(j);
+  }
   // Remove the context for `hdl`, making sure clients receive an error in case
   // this connection was closed during handshake.
   auto i = ctx.find(hdl);
@@ -563,6 +638,14 @@ behavior basp_broker::make_behavior() {
         srb(src, mid);
       }
     },
+    // received from detail::multicast, e.g., for group communication
+    [=](multicast_atom, strong_actor_ptr& src,
+        const std::vector<strong_actor_ptr>& dests, const message& msg) {
+      CAF_LOG_TRACE(CAF_ARG(src) << CAF_ARG(dests) << CAF_ARG(msg));
+      if (src && system().node() == src->node())
+        system().registry().put(src->id(), src);
+      state.instance.multicast(context(), src, dests, msg);
+    },
     // received from some system calls like whereis
     [=](forward_atom, const node_id& dest_node, atom_value dest_name,
         const message& msg) -> result<message> {
@@ -604,6 +687,11 @@ behavior basp_broker::make_behavior() {
       configure_read(msg.handle, receive_policy::exactly(basp::header_size));
     },
     // received from underlying broker implementation
+    [=](const data_transferred_msg& msg) {
+      CAF_LOG_TRACE(CAF_ARG(msg.handle) << CAF_ARG(msg.remaining));
+      state.handle_data_transferred(msg);
+    },
+    // received from underlying broker implementation
     [=](const connection_closed_msg& msg) {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
       state.cleanup(msg.handle);
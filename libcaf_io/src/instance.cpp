@@ -19,6 +19,8 @@
 
 #include "caf/io/basp/instance.hpp"
 
+#include <algorithm>
+
 #include "caf/streambuf.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/binary_deserializer.hpp"
@@ -357,6 +359,69 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
   return true;
 }
 
+size_t instance::multicast(execution_unit* ctx,
+                           const strong_actor_ptr& sender,
+                           const std::vector<strong_actor_ptr>& receivers,
+                           const message& msg) {
+  CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(receivers) << CAF_ARG(msg));
+  // The first frame serializes the payload into the write buffer of its
+  // route, all other frames copy the serialized bytes from there. Flushing
+  // hands the write buffer over to the connection, hence we flush only after
+  // writing all frames.
+  std::vector<routing_table::route> routes;
+  buffer_type* payload = nullptr;
+  size_t payload_pos = 0;
+  uint32_t plen = 0;
+  size_t failed = 0;
+  for (auto& receiver : receivers) {
+    if (!receiver || system().node() == receiver->node()) {
+      CAF_LOG_WARNING("cannot forward to invalid or local actor:"
+                      << CAF_ARG(receiver));
+      ++failed;
+      continue;
+    }
+    auto path = lookup(receiver->node());
+    if (!path) {
+      notify<hook::message_sending_failed>(sender, receiver,
+                                           invalid_message_id, msg);
+      ++failed;
+      continue;
+    }
+    header hdr{message_type::dispatch_message, 0, plen,
+               message_id{invalid_message_id}.integer_value(),
+               sender ? sender->node() : this_node(), receiver->node(),
+               sender ? sender->id() : invalid_actor_id, receiver->id()};
+    auto& buf = path->wr_buf;
+    if (payload == nullptr) {
+      auto writer = make_callback([&](serializer& sink) -> error {
+        std::vector<strong_actor_ptr> forwarding_stack;
+        return sink(forwarding_stack, const_cast<message&>(msg));
+      });
+      write(ctx, buf, hdr, &writer);
+      plen = hdr.payload_len;
+      payload = &buf;
+      payload_pos = buf.size() - plen;
+    } else {
+      write(ctx, buf, hdr);
+      // use indexes, since `buf` and `*payload` may be the same buffer
+      auto pos = buf.size();
+      buf.resize(pos + plen);
+      std::copy_n(payload->begin() + static_cast<ptrdiff_t>(payload_pos),
+                  plen, buf.begin() + static_cast<ptrdiff_t>(pos));
+    }
+    auto pred = [&](const routing_table::route& x) {
+      return x.hdl == path->hdl;
+    };
+    if (std::none_of(routes.begin(), routes.end(), pred))
+      routes.push_back(*path);
+    notify<hook::message_sent>(sender, path->next_hop, receiver,
+                               invalid_message_id, msg);
+  }
+  for (auto& r : routes)
+    flush(r);
+  return failed;
+}
+
 void instance::write(execution_unit* ctx, buffer_type& buf,
                      header& hdr, payload_writer* pw) {
   CAF_LOG_TRACE(CAF_ARG(hdr));
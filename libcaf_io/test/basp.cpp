@@ -35,6 +35,8 @@
 
 #include "caf/deep_to_string.hpp"
 
+#include "caf/detail/multicast.hpp"
+
 #include "caf/io/network/interfaces.hpp"
 #include "caf/io/network/test_multiplexer.hpp"
 
@@ -588,6 +590,100 @@ CAF_TEST(message_forwarding) {
           msg);
 }
 
+CAF_TEST(multicast) {
+  connect_node(jupiter());
+  auto jupiter_prx = proxies().get_or_put(jupiter().id,
+                                          jupiter().dummy_actor->id());
+  mock()
+  .receive(jupiter().connection,
+          basp::message_type::announce_proxy, no_flags, no_payload,
+          no_operation_data, this_node(), jupiter().id,
+          invalid_actor_id, jupiter().dummy_actor->id());
+  connect_node(mars());
+  auto mars_prx = proxies().get_or_put(mars().id, mars().dummy_actor->id());
+  mock()
+  .receive(mars().connection,
+          basp::message_type::announce_proxy, no_flags, no_payload,
+          no_operation_data, this_node(), mars().id,
+          invalid_actor_id, mars().dummy_actor->id());
+  CAF_MESSAGE("send a single multicast message to the BASP broker");
+  auto msg = make_message(1, 2, 3);
+  detail::multicast(self()->ctrl(), {jupiter_prx, mars_prx}, msg, nullptr);
+  mock()
+  .receive(jupiter().connection,
+          basp::message_type::dispatch_message, no_flags, any_vals,
+          no_operation_data, this_node(), jupiter().id,
+          self()->id(), jupiter().dummy_actor->id(),
+          std::vector<actor_id>{}, msg)
+  .receive(mars().connection,
+          basp::message_type::dispatch_message, no_flags, any_vals,
+          no_operation_data, this_node(), mars().id,
+          self()->id(), mars().dummy_actor->id(),
+          std::vector<actor_id>{}, msg);
+}
+
+CAF_TEST(stream_credit_throttling) {
+  connect_node(jupiter());
+  auto limit = sys.config().middleman_max_pending_stream_bytes;
+  auto send_stream_msg = [&](stream_msg::content_type content, actor_id src) {
+    auto msg = make_message(stream_msg{stream_id{}, actor_addr{},
+                                       std::move(content)});
+    mock(jupiter().connection,
+         {basp::message_type::dispatch_message, 0, 0, 0,
+          jupiter().id, this_node(), src, self()->id()},
+         std::vector<actor_addr>{}, msg);
+  };
+  auto send_credit = [&](int32_t credit) {
+    send_stream_msg(stream_msg::ack_batch{credit, 0}, invalid_actor_id);
+  };
+  // returns the credit of an ack_batch or the size of a batch
+  auto received_credit = [&] {
+    int32_t result = 0;
+    self()->receive(
+      [&](stream_msg& x) {
+        if (holds_alternative<stream_msg::batch>(x.content))
+          result = get<stream_msg::batch>(x.content).xs_size;
+        else
+          result = get<stream_msg::ack_batch>(x.content).new_capacity;
+      },
+      after(std::chrono::seconds(0)) >> [] {
+        // nop
+      }
+    );
+    return result;
+  };
+  auto& sc = mpx()->impl_ptr(jupiter().connection);
+  CAF_MESSAGE("deliver credit immediately without unsent bytes");
+  send_credit(1);
+  CAF_CHECK_EQUAL(received_credit(), 1);
+  CAF_CHECK(mpx()->ack_writes(jupiter().connection));
+  CAF_MESSAGE("hold back credit while too many bytes wait for transmission");
+  sc->data_transferred(mpx(), 0, limit + 1);
+  send_credit(2);
+  send_credit(3);
+  CAF_CHECK_EQUAL(received_credit(), 0);
+  CAF_MESSAGE("release credit in order once the connection drained");
+  sc->data_transferred(mpx(), limit + 1, 0);
+  CAF_CHECK_EQUAL(received_credit(), 2);
+  CAF_CHECK_EQUAL(received_credit(), 3);
+  CAF_CHECK_EQUAL(received_credit(), 0);
+  CAF_CHECK(!mpx()->ack_writes(jupiter().connection));
+  CAF_MESSAGE("hold back other stream messages only for the same sender");
+  send_credit(4);
+  CAF_CHECK_EQUAL(received_credit(), 4);
+  sc->data_transferred(mpx(), 0, limit + 1);
+  send_credit(5);
+  send_stream_msg(stream_msg::batch{6, make_message(), 0}, invalid_actor_id);
+  send_stream_msg(stream_msg::batch{7, make_message(), 0}, 42);
+  CAF_CHECK_EQUAL(received_credit(), 7);
+  CAF_CHECK_EQUAL(received_credit(), 0);
+  CAF_MESSAGE("deliver held back credit when closing the connection");
+  anon_send(aut(), connection_closed_msg{jupiter().connection});
+  mpx()->exec_runnable();
+  CAF_CHECK_EQUAL(received_credit(), 5);
+  CAF_CHECK_EQUAL(received_credit(), 6);
+}
+
 CAF_TEST(publish_and_connect) {
   auto ax = accept_handle::from_int(4242);
   mpx()->provide_acceptor(4242, ax);
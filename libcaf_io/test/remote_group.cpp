@@ -22,6 +22,7 @@
 #define CAF_SUITE io_dynamic_remote_group
 #include "caf/test/unit_test.hpp"
 
+#include <chrono>
 #include <vector>
 #include <algorithm>
 
@@ -123,6 +124,20 @@ behavior make_server_behavior(event_based_actor* self) {
   };
 }
 
+behavior make_topic_server_behavior(event_based_actor* self) {
+  return {
+    [=](get_group_atom) {
+      return *self->system().groups().get("topic", "sensors/*/temp");
+    },
+    [=](get_group_atom, const std::string& pattern) {
+      return *self->system().groups().get("topic", pattern);
+    },
+    [=](put_atom, const std::string& topic, int x) {
+      self->send(*self->system().groups().get("topic", topic), x);
+    }
+  };
+}
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(dynamic_remote_group_tests, fixture)
@@ -168,4 +183,126 @@ CAF_TEST(client_side_group_comm) {
                     client_side.groups().get_local("foobar"));
 }
 
+CAF_TEST(remote_topic_group) {
+  // server side
+  auto server = server_side.spawn(make_topic_server_behavior);
+  CAF_EXP_THROW(port, server_side_mm.publish(server, 0, local_host));
+  CAF_REQUIRE(port != 0);
+  // client side
+  CAF_EXP_THROW(remote_server, client_side_mm.remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  group grp;
+  self->request(remote_server, infinite, get_group_atom::value).receive(
+    [&](const group& x) {
+      grp = x;
+    },
+    [&](error& err) {
+      CAF_FAIL("error: " << client_side.render(err));
+    }
+  );
+  self->join(grp);
+  // the proxy subscribes asynchronously, so we publish until we receive
+  bool subscribed = false;
+  for (int i = 0; i < 100 && !subscribed; ++i) {
+    self->send(remote_server, put_atom::value, "sensors/eu/temp", 1);
+    self->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, 1);
+        subscribed = true;
+      },
+      after(std::chrono::milliseconds(50)) >> [] {
+        // nop
+      }
+    );
+  }
+  CAF_REQUIRE(subscribed);
+  // messages for topics not matching our pattern never reach us
+  self->send(remote_server, put_atom::value, "sensors/eu/humidity", 2);
+  self->send(remote_server, put_atom::value, "sensors/eu/temp", 3);
+  bool done = false;
+  while (!done) {
+    self->receive(
+      [&](int x) {
+        CAF_CHECK_NOT_EQUAL(x, 2);
+        done = x == 3;
+      },
+      after(std::chrono::seconds(5)) >> [&] {
+        CAF_FAIL("timeout while waiting for published message");
+      }
+    );
+  }
+  self->leave(grp);
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
+CAF_TEST(remote_topic_group_with_overlapping_patterns) {
+  // server side
+  auto server = server_side.spawn(make_topic_server_behavior);
+  CAF_EXP_THROW(port, server_side_mm.publish(server, 0, local_host));
+  CAF_REQUIRE(port != 0);
+  // client side
+  CAF_EXP_THROW(remote_server, client_side_mm.remote_actor(local_host, port));
+  scoped_actor self{client_side};
+  std::vector<group> grps;
+  for (auto pattern : {"sensors/*/temp", "sensors/**"})
+    self->request(remote_server, infinite, get_group_atom::value,
+                  std::string{pattern}).receive(
+      [&](const group& x) {
+        grps.push_back(x);
+      },
+      [&](error& err) {
+        CAF_FAIL("error: " << client_side.render(err));
+      }
+    );
+  for (auto& grp : grps)
+    self->join(grp);
+  // both proxies subscribe via the same proxy broker in order, i.e., the
+  // server knows both patterns once we receive messages for the second one
+  bool subscribed = false;
+  for (int i = 0; i < 100 && !subscribed; ++i) {
+    self->send(remote_server, put_atom::value, "sensors/eu/humidity", 1);
+    self->receive(
+      [&](int x) {
+        CAF_CHECK_EQUAL(x, 1);
+        subscribed = true;
+      },
+      after(std::chrono::milliseconds(50)) >> [] {
+        // nop
+      }
+    );
+  }
+  CAF_REQUIRE(subscribed);
+  // drain messages from the previous loop
+  self->send(remote_server, put_atom::value, "sensors/eu/humidity", 3);
+  bool drained = false;
+  while (!drained) {
+    self->receive(
+      [&](int x) {
+        drained = x == 3;
+      },
+      after(std::chrono::seconds(5)) >> [&] {
+        CAF_FAIL("timeout while waiting for published message");
+      }
+    );
+  }
+  // both patterns match, but each message arrives only once
+  self->send(remote_server, put_atom::value, "sensors/eu/temp", 4);
+  self->send(remote_server, put_atom::value, "sensors/eu/humidity", 5);
+  std::vector<int> xs;
+  while (xs.empty() || xs.back() != 5) {
+    self->receive(
+      [&](int x) {
+        xs.push_back(x);
+      },
+      after(std::chrono::seconds(5)) >> [&] {
+        CAF_FAIL("timeout while waiting for published message");
+      }
+    );
+  }
+  CAF_CHECK_EQUAL(xs, std::vector<int>({4, 5}));
+  for (auto& grp : grps)
+    self->leave(grp);
+  anon_send_exit(server, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()